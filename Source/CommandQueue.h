@@ -0,0 +1,46 @@
+// CommandQueue.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+// Fixed-size lock-free queue for sending small commands to the audio thread.
+// Any number of non-audio threads may push (they serialise on a spin lock the audio
+// thread never touches); the audio thread drains whatever has arrived at a block boundary.
+template <typename T, int Capacity>
+class CommandQueue
+{
+public:
+    // returns false if the queue is full
+    bool push(const T& item)
+    {
+        const juce::SpinLock::ScopedLockType lock(writerLock);
+        auto scope = fifo.write(1);
+        if (scope.blockSize1 > 0)
+        {
+            items[(size_t)scope.startIndex1] = item;
+            return true;
+        }
+        if (scope.blockSize2 > 0)
+        {
+            items[(size_t)scope.startIndex2] = item;
+            return true;
+        }
+        return false;
+    }
+
+    // audio thread: calls fn for every queued item, oldest first
+    template <typename Fn>
+    void drain(Fn&& fn)
+    {
+        auto scope = fifo.read(fifo.getNumReady());
+        for (int i = 0; i < scope.blockSize1; ++i)
+            fn(items[(size_t)(scope.startIndex1 + i)]);
+        for (int i = 0; i < scope.blockSize2; ++i)
+            fn(items[(size_t)(scope.startIndex2 + i)]);
+    }
+
+private:
+    juce::AbstractFifo fifo{ Capacity };
+    std::array<T, Capacity> items{};
+    juce::SpinLock writerLock;
+};
@@ -0,0 +1,135 @@
+// Curve.h
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <algorithm>
+#include "Trace.h"
+
+// Drawable LFO shape: control points plus a tension per segment.
+// Lives outside WaveformEditor so the processor can save it and bake it without a GUI.
+struct Curve
+{
+    struct Point { float x, y; };
+    struct Segment { float tension = 0.0f; };
+
+    std::vector<Point> points{ {0.0f, 0.5f}, {0.5f, 1.0f}, {1.0f, 0.5f} };
+    std::vector<Segment> segments = std::vector<Segment>(2);
+
+    // keep one segment per pair of points
+    void syncSegments() { segments.resize(std::max<size_t>(1, points.size() - 1)); }
+
+    // sample using quadratic bezier per segment using tension -> control point
+    float sample(float t) const
+    {
+        if (points.empty()) return 0.5f;
+        if (t <= points.front().x) return points.front().y;
+        if (t >= points.back().x) return points.back().y;
+
+        for (size_t i = 0; i + 1 < points.size(); ++i)
+        {
+            if (t >= points[i].x && t <= points[i + 1].x)
+            {
+                float segT = (t - points[i].x) / (points[i + 1].x - points[i].x);
+                float y1 = points[i].y;
+                float y2 = points[i + 1].y;
+                float tension = (i < segments.size()) ? segments[i].tension : 0.0f;
+
+                // controlY near midpoint adjusted by tension
+                float controlY = juce::jlimit(0.0f, 1.0f, 0.5f * (y1 + y2) + tension * 0.5f);  //<------change first number for change in tension stardew
+
+                float inv = 1.0f - segT;
+                return inv * inv * y1 + 2.0f * inv * segT * controlY + segT * segT * y2;
+            }
+        }
+        return points.back().y;
+    }
+
+    // bake N samples into dest, optional 3-tap smoothing, clamped to 0..1 (no allocation)
+    void bake(float* dest, int N, bool smooth) const
+    {
+        CHRONOS_TRACE_SCOPE("Curve::bake");
+        if (N <= 0) return;
+
+        for (int i = 0; i < N; ++i)
+            dest[i] = sample((float)i / (float)N);
+
+        if (smooth)
+        {
+            // circular 3-tap moving average done in place
+            float first = dest[0];
+            float prev = dest[N - 1];
+            for (int i = 0; i < N; ++i)
+            {
+                float cur = dest[i];
+                float next = (i + 1 < N) ? dest[i + 1] : first;
+                dest[i] = (prev + cur + next) / 3.0f;
+                prev = cur;
+            }
+        }
+
+        for (int i = 0; i < N; ++i)
+            dest[i] = juce::jlimit(0.0f, 1.0f, dest[i]);
+    }
+
+    std::vector<float> createSampleBuffer(int N = 512, bool smooth = false) const
+    {
+        CHRONOS_TRACE_SCOPE("Curve::createSampleBuffer");
+        std::vector<float> out((size_t)std::max(0, N));
+        bake(out.data(), N, smooth);
+        return out;
+    }
+
+    //==========================================================================
+    // compact binary form: point count, x/y pairs, then one tension per segment
+    void writeTo(juce::OutputStream& out) const
+    {
+        out.writeCompressedInt((int)points.size());
+        for (auto& p : points)
+        {
+            out.writeFloat(p.x);
+            out.writeFloat(p.y);
+        }
+
+        out.writeCompressedInt((int)segments.size());
+        for (auto& s : segments)
+            out.writeFloat(s.tension);
+    }
+
+    // returns false (and leaves the curve untouched) if the data is truncated or nonsense
+    bool readFrom(juce::InputStream& in)
+    {
+        const int maxPoints = 4096;
+
+        int numPoints = in.readCompressedInt();
+        if (numPoints < 2 || numPoints > maxPoints || in.getNumBytesRemaining() < (juce::int64)numPoints * 8)
+            return false;
+
+        std::vector<Point> newPoints((size_t)numPoints);
+        for (auto& p : newPoints)
+        {
+            p.x = in.readFloat();
+            p.y = in.readFloat();
+            if (!std::isfinite(p.x) || !std::isfinite(p.y))
+                return false;
+            p.x = juce::jlimit(0.0f, 1.0f, p.x);
+            p.y = juce::jlimit(0.0f, 1.0f, p.y);
+        }
+        std::sort(newPoints.begin(), newPoints.end(), [](const Point& a, const Point& b) { return a.x < b.x; });
+
+        int numSegments = in.readCompressedInt();
+        if (numSegments < 0 || numSegments > maxPoints || in.getNumBytesRemaining() < (juce::int64)numSegments * 4)
+            return false;
+
+        std::vector<Segment> newSegments((size_t)numSegments);
+        for (auto& s : newSegments)
+        {
+            float t = in.readFloat();
+            s.tension = std::isfinite(t) ? juce::jlimit(-1.0f, 1.0f, t) : 0.0f;
+        }
+
+        points = std::move(newPoints);
+        segments = std::move(newSegments);
+        syncSegments();
+        return true;
+    }
+};
@@ -0,0 +1,135 @@
+// CurveBaker.h
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include "Curve.h"
+#include "LFO.h"
+#include "ShapeSequencer.h"
+
+// Bakes curve edits into LFO tables on one worker thread, shared by every instance.
+// submit() just drops a snapshot in a mailbox and wakes the worker, so the GUI never bakes.
+// There's one slot per (LFO, table) and one per shape sequencer: a burst of edits during a
+// drag overwrites the slot, and only the newest curve gets baked - nothing queues up behind
+// a slow bake.
+class CurveBaker : private juce::Thread
+{
+public:
+    CurveBaker() : juce::Thread("Curve baker")
+    {
+        scratch.resize((size_t)LFO::maxTableSize);
+        startThread(juce::Thread::Priority::high); // edits should be audible within a couple of ms
+    }
+
+    ~CurveBaker() override { stopThread(2000); }
+
+    // any thread but the audio thread
+    void submit(LFO& lfo, bool toMorphTable, const Curve& curve, int resolution = 1024)
+    {
+        {
+            const juce::ScopedLock sl(mailboxLock);
+
+            auto& job = slotFor(&lfo, nullptr, toMorphTable);
+            job.curve = curve; // coalesce: the newest snapshot wins
+            job.resolution = juce::jlimit(2, LFO::maxTableSize, resolution);
+        }
+
+        notify();
+    }
+
+    // the drawn-curve table of a shape sequencer, same mailbox rules
+    void submit(ShapeSequencer& sequencer, const Curve& curve)
+    {
+        {
+            const juce::ScopedLock sl(mailboxLock);
+            auto& job = slotFor(nullptr, &sequencer, false);
+            job.curve = curve;
+            job.resolution = ShapeSequencer::tableSize;
+        }
+
+        notify();
+    }
+
+    // forget anything pending for this LFO and wait out a bake in progress - call before it dies
+    void cancel(LFO& lfo)
+    {
+        const juce::ScopedLock bl(bakeLock);
+        const juce::ScopedLock sl(mailboxLock);
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [&](const Job& j) { return j.lfo == &lfo; }),
+                      pending.end());
+    }
+
+    void cancel(ShapeSequencer& sequencer)
+    {
+        const juce::ScopedLock bl(bakeLock);
+        const juce::ScopedLock sl(mailboxLock);
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [&](const Job& j) { return j.sequencer == &sequencer; }),
+                      pending.end());
+    }
+
+private:
+    struct Job
+    {
+        LFO* lfo = nullptr;                  // either an LFO table...
+        ShapeSequencer* sequencer = nullptr; // ...or a sequencer's drawn table
+        bool toMorphTable = false;
+        Curve curve;
+        int resolution = 1024;
+    };
+
+    juce::CriticalSection mailboxLock, bakeLock;
+    std::vector<Job> pending;
+    Job current;
+    std::vector<float> scratch; // maxTableSize, so baking never allocates
+
+    static_assert(ShapeSequencer::tableSize <= LFO::maxTableSize, "scratch holds either table");
+
+    // mailboxLock held
+    Job& slotFor(LFO* lfo, ShapeSequencer* sequencer, bool toMorphTable)
+    {
+        auto it = std::find_if(pending.begin(), pending.end(), [&](const Job& j)
+                               { return j.lfo == lfo && j.sequencer == sequencer && j.toMorphTable == toMorphTable; });
+
+        if (it == pending.end())
+            it = pending.insert(pending.end(), Job{ lfo, sequencer, toMorphTable });
+        return *it;
+    }
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            {
+                // held across take + bake + publish, so cancel() can't return mid-bake
+                const juce::ScopedLock bl(bakeLock);
+
+                bool haveJob = false;
+                {
+                    const juce::ScopedLock sl(mailboxLock);
+                    if (!pending.empty())
+                    {
+                        std::swap(current, pending.front()); // swap keeps both curves' storage around
+                        pending.erase(pending.begin());
+                        haveJob = true;
+                    }
+                }
+
+                if (haveJob)
+                {
+                    current.curve.bake(scratch.data(), current.resolution, true);
+
+                    if (current.sequencer != nullptr)
+                        current.sequencer->setDrawnTable(scratch.data(), current.resolution);
+                    else if (current.toMorphTable)
+                        current.lfo->setMorphWaveform(scratch.data(), current.resolution);
+                    else
+                        current.lfo->setCustomWaveform(scratch.data(), current.resolution);
+                    continue;
+                }
+            }
+
+            wait(-1);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(CurveBaker)
+};
@@ -0,0 +1,122 @@
+// DspLoadMeter.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+// Times processBlock against its real-time budget (numSamples / sampleRate).
+// The audio thread only does relaxed atomic adds and compares; the GUI reads a snapshot
+// whenever it likes. Load is a proportion: 1.0 means the block took its whole budget.
+class DspLoadMeter
+{
+public:
+    static constexpr int numBuckets = 41;          // 0..200% in 5% steps, the last one is everything above
+    static constexpr float bucketWidth = 0.05f;
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        reset();
+    }
+
+    // message thread: start counting from scratch
+    void reset()
+    {
+        for (auto& b : histogram)
+            b.store(0, std::memory_order_relaxed);
+
+        blocks = 0;
+        overruns = 0;
+        loadSum = 0;
+        lastLoad = 0.0f;
+        peakLoad = 0.0f;
+        smallestBlock = std::numeric_limits<int>::max();
+        largestBlock = 0;
+    }
+
+    // audio thread: times the scope it lives in
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(DspLoadMeter& m, int n) : meter(m), numSamples(n), start(juce::Time::getHighResolutionTicks()) {}
+        ~ScopedTimer() { meter.record(juce::Time::getHighResolutionTicks() - start, numSamples); }
+
+    private:
+        DspLoadMeter& meter;
+        const int numSamples;
+        const juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedTimer)
+    };
+
+    void record(juce::int64 ticks, int numSamples)
+    {
+        if (numSamples <= 0 || sampleRate <= 0.0)
+            return;
+
+        const double budgetTicks = (double)numSamples / sampleRate * ticksPerSecond;
+        const float load = (float)((double)ticks / budgetTicks);
+
+        lastLoad.store(load, std::memory_order_relaxed);
+        histogram[(size_t)juce::jlimit(0, numBuckets - 1, (int)(load / bucketWidth))].fetch_add(1, std::memory_order_relaxed);
+        blocks.fetch_add(1, std::memory_order_relaxed);
+        loadSum.fetch_add((juce::uint64)(load * 1.0e6f), std::memory_order_relaxed);
+
+        if (load > 1.0f)
+            overruns.fetch_add(1, std::memory_order_relaxed);
+
+        atomicMax(peakLoad, load);
+        atomicMax(largestBlock, numSamples);
+        atomicMin(smallestBlock, numSamples);
+    }
+
+    struct Snapshot
+    {
+        float last = 0.0f, average = 0.0f, peak = 0.0f;
+        juce::uint64 blocks = 0, overruns = 0;
+        int smallestBlock = 0, largestBlock = 0;
+        std::array<juce::uint32, numBuckets> histogram{};
+    };
+
+    // any thread; the fields are read one by one, so they can be a block apart
+    Snapshot getSnapshot() const
+    {
+        Snapshot s;
+        s.last = lastLoad.load(std::memory_order_relaxed);
+        s.peak = peakLoad.load(std::memory_order_relaxed);
+        s.blocks = blocks.load(std::memory_order_relaxed);
+        s.overruns = overruns.load(std::memory_order_relaxed);
+        s.average = s.blocks > 0 ? (float)((double)loadSum.load(std::memory_order_relaxed) * 1.0e-6 / (double)s.blocks) : 0.0f;
+
+        const int smallest = smallestBlock.load(std::memory_order_relaxed);
+        s.smallestBlock = smallest == std::numeric_limits<int>::max() ? 0 : smallest;
+        s.largestBlock = largestBlock.load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < histogram.size(); ++i)
+            s.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    double sampleRate = 0.0;
+    const double ticksPerSecond = (double)juce::Time::getHighResolutionTicksPerSecond();
+
+    std::array<std::atomic<juce::uint32>, numBuckets> histogram{};
+    std::atomic<juce::uint64> blocks{ 0 }, overruns{ 0 }, loadSum{ 0 }; // loadSum in millionths
+    std::atomic<float> lastLoad{ 0.0f }, peakLoad{ 0.0f };
+    std::atomic<int> smallestBlock{ std::numeric_limits<int>::max() }, largestBlock{ 0 };
+
+    template <typename T>
+    static void atomicMax(std::atomic<T>& target, T value)
+    {
+        auto current = target.load(std::memory_order_relaxed);
+        while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    template <typename T>
+    static void atomicMin(std::atomic<T>& target, T value)
+    {
+        auto current = target.load(std::memory_order_relaxed);
+        while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+};
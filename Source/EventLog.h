@@ -0,0 +1,232 @@
+// EventLog.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+// Diagnostic log the audio thread can write to. Each processor owns an EventLog: a fixed
+// ring of small binary records, pushed without locks or allocation (if it's full the record
+// is counted as dropped instead). One EventLogWriter thread shared by every instance drains
+// them a few times a second into a text file that rotates, so it can stay on in real sessions.
+class EventLog
+{
+public:
+    enum class Type : juce::uint8
+    {
+        TransportStart,
+        TransportStop,
+        PlayheadJump,    // a = expected ppq, b = ppq the host gave us
+        TempoChange,     // a = old bpm, b = new bpm
+        ModeChange,      // a = old mode, b = new mode
+        TableSwap,       // detail 0 = curve A, 1 = curve B; a = tables picked up this block
+        CommandsDropped, // a = rate commands the full queue turned away
+        SanityCheck,     // detail = which Value; a = what it was before it got replaced
+        NotPrepared      // processBlock before prepareToPlay
+    };
+
+    // what a SanityCheck record is about
+    enum class Value : juce::uint8 { HostBpm, Mix, Volume, Division };
+
+    struct Record
+    {
+        juce::int64 ticks = 0;       // high resolution ticks when it happened
+        juce::int64 hostSample = -1; // host timeline position of the block, -1 if unknown
+        Type type = Type::TransportStart;
+        juce::uint8 detail = 0;
+        float a = 0.0f, b = 0.0f;
+    };
+
+    static constexpr int capacity = 1024;
+
+    // audio thread: where the host says this block is, stamped on everything pushed during it
+    void beginBlock(juce::int64 hostSamplePosition) { blockSample = hostSamplePosition; }
+
+    // audio thread only (single producer)
+    void push(Type type, int detail = 0, float a = 0.0f, float b = 0.0f)
+    {
+        auto scope = fifo.write(1);
+        if (scope.blockSize1 + scope.blockSize2 == 0)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto& r = records[(size_t)(scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)];
+        r.ticks = juce::Time::getHighResolutionTicks();
+        r.hostSample = blockSample;
+        r.type = type;
+        r.detail = (juce::uint8)detail;
+        r.a = a;
+        r.b = b;
+    }
+
+    // writer thread: everything pushed so far, oldest first
+    template <typename Fn>
+    void drain(Fn&& fn)
+    {
+        auto scope = fifo.read(fifo.getNumReady());
+        for (int i = 0; i < scope.blockSize1; ++i)
+            fn(records[(size_t)(scope.startIndex1 + i)]);
+        for (int i = 0; i < scope.blockSize2; ++i)
+            fn(records[(size_t)(scope.startIndex2 + i)]);
+    }
+
+    juce::uint32 takeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+    int getInstanceNumber() const { return instanceNumber; }
+
+private:
+    friend class EventLogWriter;
+
+    juce::AbstractFifo fifo{ capacity };
+    std::array<Record, capacity> records{};
+    std::atomic<juce::uint32> dropped{ 0 };
+    juce::int64 blockSample = -1;
+    int instanceNumber = 0;
+};
+
+// Drains every instance's EventLog to <app data>/Chronos/Logs/events.log, rolling it over
+// to events.1.log .. events.3.log past a size limit. Never touched by the audio thread.
+class EventLogWriter : private juce::Thread
+{
+public:
+    static constexpr juce::int64 maxFileSize = 1024 * 1024;
+    static constexpr int numOldFiles = 3;
+
+    EventLogWriter() : juce::Thread("Chronos event log")
+    {
+        startThread(juce::Thread::Priority::background);
+    }
+
+    ~EventLogWriter() override
+    {
+        stopThread(2000);
+        writePending(); // whatever came in after the last pass
+    }
+
+    void add(EventLog& log)
+    {
+        const juce::ScopedLock lock(logsLock);
+        log.instanceNumber = ++instancesSeen;
+        logs.push_back(&log);
+    }
+
+    // flushes what it still holds first, so the last events of a closing instance survive
+    void remove(EventLog& log)
+    {
+        const juce::ScopedLock lock(logsLock);
+        writeLocked(&log);
+        logs.erase(std::remove(logs.begin(), logs.end(), &log), logs.end());
+    }
+
+    static juce::File getLogFile()
+    {
+        return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+            .getChildFile("Chronos").getChildFile("Logs").getChildFile("events.log");
+    }
+
+private:
+    juce::CriticalSection logsLock;
+    std::vector<EventLog*> logs;
+    int instancesSeen = 0;
+
+    // ticks -> wall clock, taken once
+    const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+    const juce::int64 startMs = juce::Time::currentTimeMillis();
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            wait(250);
+            writePending();
+        }
+    }
+
+    void writePending()
+    {
+        const juce::ScopedLock lock(logsLock);
+        writeLocked(nullptr);
+    }
+
+    // one log, or all of them if onlyThis is null
+    void writeLocked(EventLog* onlyThis)
+    {
+        juce::String text;
+        for (auto* log : logs)
+        {
+            if (onlyThis != nullptr && log != onlyThis)
+                continue;
+
+            log->drain([&](const EventLog::Record& r) { text << format(*log, r) << juce::newLine; });
+
+            if (auto n = log->takeDropped())
+                text << timestamp(juce::Time::getHighResolutionTicks()) << "  #" << log->getInstanceNumber()
+                     << "  log full, " << (int)n << " event(s) lost" << juce::newLine;
+        }
+
+        if (text.isNotEmpty())
+            append(text);
+    }
+
+    void append(const juce::String& text)
+    {
+        auto file = getLogFile();
+        if (file.getSize() > maxFileSize)
+            rotate(file);
+
+        file.getParentDirectory().createDirectory();
+        juce::FileOutputStream out(file); // appends
+        if (out.openedOk())
+            out.writeText(text, false, false, nullptr);
+    }
+
+    static void rotate(const juce::File& file)
+    {
+        auto numbered = [&file](int n)
+        {
+            return file.getSiblingFile(file.getFileNameWithoutExtension() + "." + juce::String(n) + file.getFileExtension());
+        };
+
+        numbered(numOldFiles).deleteFile();
+        for (int n = numOldFiles - 1; n >= 1; --n)
+            numbered(n).moveFileTo(numbered(n + 1));
+        file.moveFileTo(numbered(1));
+    }
+
+    juce::String timestamp(juce::int64 ticks) const
+    {
+        const double ms = juce::Time::highResolutionTicksToSeconds(ticks - startTicks) * 1000.0;
+        return juce::Time(startMs + (juce::int64)ms).formatted("%Y-%m-%d %H:%M:%S.")
+             + juce::String((startMs + (juce::int64)ms) % 1000).paddedLeft('0', 3);
+    }
+
+    juce::String format(const EventLog& log, const EventLog::Record& r) const
+    {
+        static const char* const modes[] = { "BPM", "Hz", "BPM/Hz" };
+        static const char* const values[] = { "host bpm", "mix", "volume", "division" };
+        auto mode = [](float m) { return juce::String(modes[juce::jlimit(0, 2, (int)m)]); };
+
+        juce::String line = timestamp(r.ticks) + "  #" + juce::String(log.getInstanceNumber())
+                          + "  @" + (r.hostSample >= 0 ? juce::String(r.hostSample) : juce::String("?")) + "  ";
+
+        switch (r.type)
+        {
+        case EventLog::Type::TransportStart:  return line + "transport started";
+        case EventLog::Type::TransportStop:   return line + "transport stopped";
+        case EventLog::Type::PlayheadJump:    return line + "playhead jumped from ppq " + juce::String(r.a, 3) + " to " + juce::String(r.b, 3);
+        case EventLog::Type::TempoChange:     return line + "tempo " + juce::String(r.a, 2) + " -> " + juce::String(r.b, 2);
+        case EventLog::Type::ModeChange:      return line + "mode " + mode(r.a) + " -> " + mode(r.b);
+        case EventLog::Type::TableSwap:       return line + "new table for curve " + (r.detail == 0 ? "A" : "B")
+                                                   + (r.a > 1.0f ? " (" + juce::String((int)r.a) + " this block)" : juce::String());
+        case EventLog::Type::CommandsDropped: return line + juce::String((int)r.a) + " rate command(s) dropped, queue full";
+        case EventLog::Type::SanityCheck:     return line + "bad " + values[juce::jlimit(0, 3, (int)r.detail)] + " (" + juce::String(r.a) + "), replaced with " + juce::String(r.b);
+        case EventLog::Type::NotPrepared:     return line + "processBlock before prepareToPlay";
+        }
+        return line + "unknown event " + juce::String((int)r.type);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(EventLogWriter)
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <JuceHeader.h>
+#include "Trace.h"
 
 // ============================================================
 // GlowEffect: reusable glow for any JUCE component
@@ -103,6 +104,7 @@ private:
 
     void timerCallback() override
     {
+        CHRONOS_TRACE_SCOPE("GlowEffect::timerCallback");
         if (!animate) return;
 
         if (mode == Mode::HueCycle)
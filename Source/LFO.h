@@ -2,11 +2,20 @@
 #pragma once
 #include <JuceHeader.h>
 #include <vector>
+#include <array>
+#include <atomic>
+#include "TripleBuffer.h"
+#include "Trace.h"
+#include "Xoshiro.h"
 
 class LFO
 {
 public:
-    enum class Shape { Saw, Sine, Triangle, Square, Custom };
+    // the two random shapes draw a new value every cycle: RandomStep holds it (sample and
+    // hold), RandomSmooth glides to it over the cycle
+    enum class Shape { Saw, Sine, Triangle, Square, Custom, RandomStep, RandomSmooth };
+
+    static constexpr int maxTableSize = 4096; // largest custom table the audio thread will take
 
     LFO()
     {
@@ -29,70 +38,216 @@ public:
     void setShape(Shape s) { shape = s; }
     Shape getShape() const { return shape; }
 
-    // Replace custom waveform (samples in range [0..1]) - thread safe
+    static bool isRandom(Shape s) { return s == Shape::RandomStep || s == Shape::RandomSmooth; }
+
+    // 0..1: every cycle gets a level of its own (down to 1 - amount) and starts up to a
+    // quarter cycle late. Applies to every shape (audio thread)
+    void setHumanize(float amount) { humanize = juce::jlimit(0.0f, 1.0f, amount); }
+
+    // restarts the random sequence, so the same seed always plays the same values from here
+    // (audio thread; the processor derives it from the user's seed and the host position)
+    void seedRandom(std::uint64_t seed)
+    {
+        random.seed(seed);
+        randomPrev = random.next();
+        randomCur = random.next();
+        levelPrev = levelCur = 1.0f;
+        switchPhase = 0.0;
+    }
+
+    // Replace custom waveform (samples in range [0..1]) - lock-free for the audio thread
     void setCustomWaveform(const std::vector<float>& samples)
     {
-        const juce::ScopedLock lock(bufferLock);
-        customBuffer = samples;
-        // precompute size to avoid repeatedly calling size() on audio thread
-        customSize = (int)customBuffer.size();
-        // ensure non-empty
-        if (customSize > 0)
-            useCustom = true;
+        setCustomWaveform(samples.data(), (int)samples.size());
     }
 
+    // copies straight into the spare table slot and publishes it, so callers can hand in
+    // already-baked data (e.g. memory-mapped presets) without another bake
+    void setCustomWaveform(const float* samples, int numSamples) { custom.set(samples, numSamples); }
+
     // Clear custom waveform and go back to normal shape
-    void clearCustomWaveform()
+    void clearCustomWaveform() { custom.clear(); }
+
+    bool hasCustomWaveform() const { return custom.isActive(); }
+
+    // Second table to morph towards (the "B" curve), same lock-free path as the custom one
+    void setMorphWaveform(const std::vector<float>& samples)
     {
-        const juce::ScopedLock lock(bufferLock);
-        customBuffer.clear();
-        customSize = 0;
-        useCustom = false;
+        setMorphWaveform(samples.data(), (int)samples.size());
     }
 
+    void setMorphWaveform(const float* samples, int numSamples) { morphTable.set(samples, numSamples); }
+    void clearMorphWaveform() { morphTable.clear(); }
+    bool hasMorphWaveform() const { return morphTable.isActive(); }
+
+    // how many new tables the audio thread has picked up so far (audio thread, for logging)
+    juce::uint32 getCustomTableSwaps() const { return custom.getSwaps(); }
+    juce::uint32 getMorphTableSwaps() const { return morphTable.getSwaps(); }
+
+    // 0 = shape/custom table only, 1 = morph table only. Ramped across the next block (audio thread)
+    void setMorph(float position) { morphTarget = juce::jlimit(0.0f, 1.0f, position); }
+
     void reset() { phase = 0.0f; }
 
+    // phase in cycles [0..1), for grid alignment
+    double getPhase() const { return phase; }
+    void setPhase(double newPhase) { phase = newPhase - std::floor(newPhase); }
+
+    // extra phase increment per sample on top of the rate, changing by 'slope' every sample.
+    // The processor sets this per block to pull the phase onto the host grid.
+    void setPhaseCorrection(double offset, double slope)
+    {
+        correction = offset;
+        correctionSlope = slope;
+    }
+
+    // restart the cycle (phase 0) exactly at this sample of the next renderBlock call.
+    // Offsets must come in ascending order; extras past maxRetriggers are dropped (audio thread)
+    void retriggerAt(int sampleOffset)
+    {
+        if (numRetriggers < maxRetriggers)
+            retriggers[(size_t)numRetriggers++] = sampleOffset;
+    }
+
+    // sizes the scratch buffer for block rendering (call from prepareToPlay)
+    void prepare(double sr, int maxBlockSize)
+    {
+        setSampleRate(sr);
+        morphScratch.assign((size_t)juce::jmax(1, maxBlockSize), 0.0f);
+        morphRamp.assign(morphScratch.size(), 0.0f);
+        phaseTrace.assign(morphScratch.size(), 0.0);
+        lastChunkSize = 0;
+        morphCurrent = morphTarget;
+    }
+
     // Get next sample in 0..1 range (audio thread)
     float getNextSample()
     {
-        float out = 0.0f;
-        if (useCustom)
+        float out = valueAt(phase, custom.read());
+        advancePhase(rateHz / sampleRate);
+
+        smoothedOut = smoothedOut * smoothingCoeff + out * (1.0f - smoothingCoeff);
+
+        return out; 
+    }
+
+    // Render a block of values in 0..1, one phase step per sample frame (audio thread).
+    // With a morph table the two curves are read at the same phases and blended with a
+    // vectorised lerp, so automation never needs a new table from the GUI.
+    void renderBlock(float* dest, int numSamples)
+    {
+        CHRONOS_TRACE_SCOPE("LFO::renderBlock");
+        const Table* tableA = custom.read();
+        const Table* tableB = morphTable.read();
+        const int chunkSize = (int)morphScratch.size();
+        const double increment = rateHz / sampleRate;
+        int nextRetrigger = 0;
+
+        for (int start = 0; start < numSamples; start += chunkSize)
         {
-            // read from customBuffer with linear interpolation
-            const juce::ScopedTryLock tryLock(bufferLock);
-            if (tryLock.isLocked() && customSize > 0)
+            const int n = juce::jmin(chunkSize, numSamples - start);
+            float* out = dest + start;
+            beginChunk(tableA, tableB, n);
+            const float m0 = lastMorphStart, m1 = lastMorphEnd;
+
+            if (tableB == nullptr || (m0 <= 0.0f && m1 <= 0.0f))
             {
-                double idx = phase * (customSize - 1);
-                int i0 = (int)floor(idx);
-                int i1 = (i0 + 1) % customSize;
-                float frac = (float)(idx - i0);
-                out = customBuffer[i0] * (1.0f - frac) + customBuffer[i1] * frac;
+                for (int i = 0; i < n; ++i)
+                {
+                    checkRetrigger(start + i, nextRetrigger);
+                    phaseTrace[(size_t)i] = phase;
+                    out[i] = valueAt(phase, tableA);
+                    advancePhase(increment);
+                }
+                continue;
             }
-            else
+
+            // A and B at the same phases, then out = A + m * (B - A)
+            float* b = morphScratch.data();
+            for (int i = 0; i < n; ++i)
             {
-                // fallback if lock failed or empty -> use saw
-                out = (float)phase;
+                checkRetrigger(start + i, nextRetrigger);
+                phaseTrace[(size_t)i] = phase;
+                out[i] = valueAt(phase, tableA);
+                b[i] = readTable(*tableB, phase);
+                advancePhase(increment);
             }
+
+            blendTowards(out, b, n, m0, m1);
         }
-        else
+
+        numRetriggers = 0;
+    }
+
+    // renderBlock without the values, for when something else owns the gain (the step gate,
+    // the sequencer): steps the phase, takes the retriggers and remembers the chunk, so
+    // renderAtPhases/renderAt and the next block carry on as if it had rendered (audio thread)
+    void advance(int numSamples)
+    {
+        const Table* tableA = custom.read();
+        const Table* tableB = morphTable.read();
+        const int chunkSize = (int)morphScratch.size();
+        const double increment = rateHz / sampleRate;
+        int nextRetrigger = 0;
+
+        for (int start = 0; start < numSamples; start += chunkSize)
         {
-            switch (shape)
+            const int n = juce::jmin(chunkSize, numSamples - start);
+            beginChunk(tableA, tableB, n);
+
+            for (int i = 0; i < n; ++i)
             {
-            case Shape::Saw:      out = (float)phase; break;
-            case Shape::Sine:     out = 0.5f + 0.5f * std::sin(juce::MathConstants<double>::twoPi * phase); break;
-            case Shape::Triangle: out = 1.0f - std::abs(juce::jmap((float)phase, 0.0f, 1.0f, -1.0f, 1.0f)); break;
-            case Shape::Square:   out = (phase < 0.5) ? 1.0f : 0.0f; break;
-            default: out = (float)phase; break;
+                checkRetrigger(start + i, nextRetrigger);
+                phaseTrace[(size_t)i] = phase;
+                advancePhase(increment);
             }
         }
 
-        // advance phase
-        phase += rateHz / sampleRate;
-        if (phase >= 1.0) phase -= 1.0;
+        numRetriggers = 0;
+    }
 
-        smoothedOut = smoothedOut * smoothingCoeff + out * (1.0f - smoothingCoeff);
+    // The same curve again at the phases the last renderBlock call stepped through, times
+    // 'multiple' plus 'offset' cycles. Gives extra LFOs (e.g. one per band) that stay locked
+    // to this one's rate, grid sync and morph without stepping a phase of their own.
+    // Only the last chunk is remembered, so keep numSamples within the prepare() block size.
+    void renderAtPhases(float* dest, int numSamples, int multiple, double offset)
+    {
+        jassert(numSamples <= lastChunkSize);
+        const int n = juce::jmin(numSamples, lastChunkSize);
+        const bool morphing = lastTableB != nullptr && (lastMorphStart > 0.0f || lastMorphEnd > 0.0f);
+        float* b = morphScratch.data();
 
-        return out; 
+        for (int i = 0; i < n; ++i)
+        {
+            double p = phaseTrace[(size_t)i] * multiple + offset;
+            p -= std::floor(p);
+            dest[i] = valueAt(p, lastTableA);
+            if (morphing)
+                b[i] = readTable(*lastTableB, p);
+        }
+
+        if (morphing)
+            blendTowards(dest, b, n, lastMorphStart, lastMorphEnd);
+    }
+
+    // The curve at any phases (0..1), with the tables and morph of the last renderBlock
+    // call: lets something else (the stutter) decide where in the cycle each sample is.
+    void renderAt(float* dest, const double* phases, int numSamples)
+    {
+        jassert(numSamples <= lastChunkSize);
+        const int n = juce::jmin(numSamples, lastChunkSize);
+        const bool morphing = lastTableB != nullptr && (lastMorphStart > 0.0f || lastMorphEnd > 0.0f);
+        float* b = morphScratch.data();
+
+        for (int i = 0; i < n; ++i)
+        {
+            dest[i] = valueAt(phases[i], lastTableA);
+            if (morphing)
+                b[i] = readTable(*lastTableB, phases[i]);
+        }
+
+        if (morphing)
+            blendTowards(dest, b, n, lastMorphStart, lastMorphEnd);
     }
 
     float getRateHz() const { return rateHz; }
@@ -111,17 +266,205 @@ public:
     }
      
 private:
-    juce::CriticalSection bufferLock;
-    std::vector<float> customBuffer;
-    int customSize = 0;
-    bool useCustom = false;
+    struct Table
+    {
+        std::array<float, maxTableSize> samples;
+        int size = 0;
+    };
+
+    // one lock-free table: writers copy into the spare slot and publish, the audio thread
+    // picks up the newest one without ever blocking
+    class TableSlot
+    {
+    public:
+        void set(const float* samples, int numSamples)
+        {
+            numSamples = juce::jmin(numSamples, maxTableSize);
+            if (samples == nullptr || numSamples <= 0)
+                return;
+
+            const juce::SpinLock::ScopedLockType lock(writerLock); // only ever taken by writers
+            auto& table = tables.getWriteBuffer();
+            std::copy(samples, samples + numSamples, table.samples.begin());
+            table.size = numSamples;
+            tables.publish();
+
+            active = true;
+        }
+
+        void clear() { active = false; }
+        bool isActive() const { return active.load(); }
+        juce::uint32 getSwaps() const { return swaps; }
+
+        // audio thread: newest published table, or nullptr if none is in use
+        const Table* read()
+        {
+            if (!active.load(std::memory_order_relaxed))
+                return nullptr;
+
+            if (tables.acquire())
+                ++swaps;
+            const auto& table = tables.getReadBuffer();
+            return table.size > 0 ? &table : nullptr;
+        }
+
+    private:
+        TripleBuffer<Table> tables;
+        juce::SpinLock writerLock;
+        std::atomic<bool> active{ false };
+        juce::uint32 swaps = 0; // audio thread
+    };
+
+    TableSlot custom;
+    TableSlot morphTable;
+
+    // morph position and block scratch (audio thread)
+    float morphTarget = 0.0f;
+    float morphCurrent = 0.0f;
+    std::vector<float> morphScratch = std::vector<float>(512);
+    std::vector<float> morphRamp = std::vector<float>(512);
+
+    // pending phase resets for the next renderBlock (audio thread)
+    static constexpr int maxRetriggers = 16;
+    std::array<int, maxRetriggers> retriggers{};
+    int numRetriggers = 0;
+
+    // what the last renderBlock chunk read, for renderAtPhases (audio thread)
+    std::vector<double> phaseTrace = std::vector<double>(512);
+    const Table* lastTableA = nullptr;
+    const Table* lastTableB = nullptr;
+    float lastMorphStart = 0.0f, lastMorphEnd = 0.0f;
+    int lastChunkSize = 0;
+
+    // moves the morph on a chunk and remembers what it read, for renderAtPhases
+    void beginChunk(const Table* tableA, const Table* tableB, int n)
+    {
+        const float m0 = morphCurrent;
+        const float m1 = (tableB != nullptr) ? morphTarget : 0.0f;
+        morphCurrent = m1;
+
+        lastTableA = tableA;
+        lastTableB = tableB;
+        lastMorphStart = m0;
+        lastMorphEnd = m1;
+        lastChunkSize = n;
+    }
+
+    // phase back to 0 if one was asked for at this sample
+    void checkRetrigger(int sample, int& nextRetrigger)
+    {
+        if (nextRetrigger < numRetriggers && retriggers[(size_t)nextRetrigger] == sample)
+        {
+            phase = 0.0;
+            newCycle();
+            correction = correctionSlope = 0.0;
+            ++nextRetrigger;
+        }
+    }
+
+    // out += m * (b - out), m ramping from m0 to m1 across the chunk; b is overwritten
+    void blendTowards(float* out, float* b, int n, float m0, float m1)
+    {
+        juce::FloatVectorOperations::subtract(b, out, n);
+
+        if (m0 == m1)
+        {
+            juce::FloatVectorOperations::multiply(b, m1, n);
+        }
+        else
+        {
+            const float step = (m1 - m0) / (float)n;
+            for (int i = 0; i < n; ++i)
+                morphRamp[(size_t)i] = m0 + step * (float)(i + 1);
+            juce::FloatVectorOperations::multiply(b, morphRamp.data(), n);
+        }
+
+        juce::FloatVectorOperations::add(out, b, n);
+    }
+
+    // linear interpolation into a baked table
+    static float readTable(const Table& table, double p)
+    {
+        const int size = table.size;
+        double idx = p * (size - 1);
+        int i0 = (int)floor(idx);
+        int i1 = (i0 + 1) % size;
+        float frac = (float)(idx - i0);
+        return table.samples[i0] * (1.0f - frac) + table.samples[i1] * frac;
+    }
+
+    float valueAt(double p, const Table* table) const
+    {
+        const float value = shapeAt(p, table);
+        if (humanize <= 0.0f)
+            return value;
+        return value * (p < switchPhase ? levelPrev : levelCur);
+    }
+
+    float shapeAt(double p, const Table* table) const
+    {
+        if (isRandom(shape)) // no table for these, the values only exist one cycle at a time
+            return randomAt(p);
+        if (table != nullptr)
+            return readTable(*table, p);
+
+        switch (shape)
+        {
+        case Shape::Saw:      return (float)p;
+        case Shape::Sine:     return 0.5f + 0.5f * (float)std::sin(juce::MathConstants<double>::twoPi * p);
+        case Shape::Triangle: return 1.0f - std::abs(juce::jmap((float)p, 0.0f, 1.0f, -1.0f, 1.0f));
+        case Shape::Square:   return (p < 0.5) ? 1.0f : 0.0f;
+        default:              return (float)p;
+        }
+    }
+
+    // the previous cycle's value up to switchPhase, then the new one (held, or eased into)
+    float randomAt(double p) const
+    {
+        if (p < switchPhase)
+            return randomPrev;
+        if (shape == Shape::RandomStep)
+            return randomCur;
+
+        const double t = (p - switchPhase) / (1.0 - switchPhase);
+        const float ease = 0.5f - 0.5f * (float)std::cos(juce::MathConstants<double>::pi * t);
+        return randomPrev + (randomCur - randomPrev) * ease;
+    }
+
+    // draws for the next cycle; always three values, so the sequence for a seed doesn't
+    // depend on the shape or the humanize amount
+    void newCycle()
+    {
+        randomPrev = randomCur;
+        randomCur = random.next();
+        levelPrev = levelCur;
+        levelCur = 1.0f - humanize * random.next();
+        switchPhase = humanize * 0.25 * random.next();
+    }
+
+    void advancePhase(double increment)
+    {
+        phase += increment + correction;
+        correction += correctionSlope;
+        if (phase >= 1.0) { phase -= 1.0; newCycle(); }
+        else if (phase < 0.0) phase += 1.0; // a strong grid correction can briefly run backwards
+    }
 
     double sampleRate = 44100.0;
     float rateHz = 1.0f;
     float bpm = 122.0f;
     double phase = 0.0;
+    double correction = 0.0;
+    double correctionSlope = 0.0;
     Shape shape = Shape::Saw;
 
+    // random shapes and humanize (audio thread)
+    Xoshiro random;
+    float randomPrev = 0.0f, randomCur = 0.0f;
+    float humanize = 0.0f;
+    float levelPrev = 1.0f, levelCur = 1.0f;
+    double switchPhase = 0.0;
+
     //smoothing
     float smoothedOut = 0.0f;
     float smoothingCoeff = 0.0f;
@@ -0,0 +1,168 @@
+// LoadHud.h
+#pragma once
+#include <JuceHeader.h>
+#include "DspLoadMeter.h"
+#include "Trace.h"
+
+// Collapsible DSP load overlay. Collapsed it's a small button showing the current load;
+// expanded it shows average/peak load, deadline overruns, the block sizes the host sent
+// and a histogram of per-block load. Polls the meter at 10 Hz, repaints the panel only when open.
+class LoadHud : public juce::Component,
+                private juce::Timer
+{
+public:
+    std::function<void()> onExpandedChanged; // owner re-lays out
+
+    explicit LoadHud(DspLoadMeter& meterToShow) : meter(meterToShow)
+    {
+        toggle.setColour(juce::TextButton::buttonColourId, juce::Colour(44, 44, 49));
+        toggle.setColour(juce::TextButton::textColourOffId, juce::Colour(35, 247, 176));
+        toggle.onClick = [this]() { setExpanded(!expanded); };
+        addAndMakeVisible(toggle);
+
+        resetButton.setColour(juce::TextButton::buttonColourId, juce::Colour(44, 44, 49));
+        resetButton.setColour(juce::TextButton::textColourOffId, juce::Colour(35, 247, 176));
+        resetButton.onClick = [this]() { meter.reset(); };
+        addChildComponent(resetButton);
+
+       #if CHRONOS_ENABLE_TRACING
+        // first click starts recording, the second writes chronos-trace-<time>.json to the desktop
+        traceButton.setColour(juce::TextButton::buttonColourId, juce::Colour(44, 44, 49));
+        traceButton.setColour(juce::TextButton::textColourOffId, juce::Colour(35, 247, 176));
+        traceButton.onClick = [this]() { toggleTracing(); };
+        addChildComponent(traceButton);
+       #endif
+
+        startTimerHz(10);
+    }
+
+    bool isExpanded() const { return expanded; }
+
+    void setExpanded(bool shouldExpand)
+    {
+        expanded = shouldExpand;
+        resetButton.setVisible(expanded);
+       #if CHRONOS_ENABLE_TRACING
+        traceButton.setVisible(expanded);
+       #endif
+        if (onExpandedChanged)
+            onExpandedChanged();
+        repaint();
+    }
+
+    // sizes for the owner's layout
+    static constexpr int collapsedWidth = 70, collapsedHeight = 20;
+    static constexpr int expandedWidth = 260, expandedHeight = 170;
+
+    void resized() override
+    {
+        auto r = getLocalBounds();
+        toggle.setBounds(r.removeFromBottom(collapsedHeight).removeFromRight(collapsedWidth));
+        resetButton.setBounds(getWidth() - 50, 4, 46, 18);
+       #if CHRONOS_ENABLE_TRACING
+        traceButton.setBounds(getWidth() - 100, 4, 46, 18);
+       #endif
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        if (!expanded)
+            return;
+
+        auto panel = getLocalBounds().withTrimmedBottom(collapsedHeight + 4).toFloat();
+        g.setColour(juce::Colour(30, 30, 34).withAlpha(0.92f));
+        g.fillRoundedRectangle(panel, 6.0f);
+        g.setColour(juce::Colour(35, 247, 176).withAlpha(0.6f));
+        g.drawRoundedRectangle(panel.reduced(0.5f), 6.0f, 1.0f);
+
+        auto text = panel.reduced(8.0f, 6.0f);
+        g.setFont(12.0f);
+        g.setColour(juce::Colours::white);
+
+        auto line = [&](const juce::String& s)
+        {
+            g.drawText(s, text.removeFromTop(15.0f), juce::Justification::centredLeft, false);
+        };
+
+        line("load  " + percent(shown.last) + "   avg " + percent(shown.average) + "   peak " + percent(shown.peak));
+        line("overruns " + juce::String((juce::int64)shown.overruns) + " / " + juce::String((juce::int64)shown.blocks) + " blocks");
+        line("block sizes " + juce::String(shown.smallestBlock) + " - " + juce::String(shown.largestBlock));
+       #if CHRONOS_ENABLE_TRACING
+        if (traceStatus.isNotEmpty())
+            line(traceStatus);
+       #endif
+
+        // histogram, log height so rare spikes still show up next to the bulk
+        auto bars = text.reduced(0.0f, 4.0f);
+        const float barWidth = bars.getWidth() / (float)DspLoadMeter::numBuckets;
+        juce::uint32 most = 1;
+        for (auto n : shown.histogram)
+            most = juce::jmax(most, n);
+
+        for (int i = 0; i < DspLoadMeter::numBuckets; ++i)
+        {
+            const auto n = shown.histogram[(size_t)i];
+            if (n == 0)
+                continue;
+
+            const float h = bars.getHeight() * (float)(std::log1p((double)n) / std::log1p((double)most));
+            const bool over = (float)i * DspLoadMeter::bucketWidth >= 1.0f;
+            g.setColour(over ? juce::Colour(238, 99, 82) : juce::Colour(35, 247, 176));
+            g.fillRect(bars.getX() + (float)i * barWidth, bars.getBottom() - h, juce::jmax(1.0f, barWidth - 1.0f), h);
+        }
+
+        // the deadline
+        const float deadlineX = bars.getX() + barWidth * (1.0f / DspLoadMeter::bucketWidth);
+        g.setColour(juce::Colours::white.withAlpha(0.5f));
+        g.drawVerticalLine((int)deadlineX, bars.getY(), bars.getBottom());
+    }
+
+private:
+    DspLoadMeter& meter;
+    DspLoadMeter::Snapshot shown;
+    bool expanded = false;
+
+    juce::TextButton toggle{ "DSP" };
+    juce::TextButton resetButton{ "reset" };
+
+   #if CHRONOS_ENABLE_TRACING
+    juce::TextButton traceButton{ "trace" };
+    juce::String traceStatus; // last thing tracing did, shown in the panel and the button's tooltip
+
+    void toggleTracing()
+    {
+        auto& trace = Trace::Registry::get();
+        if (!trace.isRecording())
+        {
+            trace.start();
+            traceButton.setButtonText("dump");
+            setTraceStatus("tracing...");
+            return;
+        }
+
+        auto file = juce::File::getSpecialLocation(juce::File::userDesktopDirectory)
+                        .getChildFile("chronos-trace-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S") + ".json");
+        setTraceStatus(trace.stopAndDump(file) ? "trace: " + file.getFileName() + " (desktop)"
+                                               : "trace: couldn't write " + file.getFullPathName());
+        traceButton.setButtonText("trace");
+    }
+
+    void setTraceStatus(const juce::String& status)
+    {
+        traceStatus = status;
+        traceButton.setTooltip(status);
+        repaint();
+    }
+   #endif
+
+    static juce::String percent(float load) { return juce::String(load * 100.0f, 1) + "%"; }
+
+    void timerCallback() override
+    {
+        shown = meter.getSnapshot();
+        toggle.setButtonText("DSP " + juce::String(juce::roundToInt(shown.last * 100.0f)) + "%");
+
+        if (expanded)
+            repaint();
+    }
+};
@@ -0,0 +1,160 @@
+// Lookahead.h
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cmath>
+#include "Trace.h"
+
+// Optional lookahead for hard gating. The audio goes through a fixed delay (one preallocated
+// ring per channel) while the gain keeps running in real time, so relative to the audio the
+// gain curve arrives 'lookaheadMs' early and an edge on a transient is already open when the
+// transient gets there. The processor reports the delay with setLatencySamples.
+//
+// Knowing the next few ms of audio also lets a gain step wait for the audio to cross zero
+// (at most the lookahead), which is what makes a square gate stop clicking.
+class Lookahead
+{
+public:
+    static constexpr double lookaheadMs = 5.0;
+    static constexpr int maxChannels = 8;
+    static constexpr float stepThreshold = 0.1f; // gain jumps bigger than this get snapped
+
+    std::atomic<bool> enabled{ false }; // message thread; see LFO2AudioProcessor::setLookahead
+
+    static int samplesFor(double sampleRate) { return juce::roundToInt(sampleRate * lookaheadMs * 0.001); }
+
+    void prepare(double sampleRate, int maxBlockSize, int numChannels)
+    {
+        delay = samplesFor(sampleRate);
+        ringSize = juce::nextPowerOfTwo(delay + juce::jmax(1, maxBlockSize) + 1);
+        ring.setSize(juce::jlimit(1, maxChannels, numChannels), ringSize);
+        reset();
+    }
+
+    void reset()
+    {
+        ring.clear();
+        writePos = 0;
+        heldGain = 1.0f;
+        holdLeft = 0;
+        lastGain = -1.0f;
+    }
+
+    // audio thread: true if this block goes through the delay
+    bool beginBlock()
+    {
+        const bool on = enabled.load(std::memory_order_relaxed) && delay > 0;
+        if (on != active)
+            reset(); // start from silence rather than whatever was left in the ring
+        active = on;
+        return active;
+    }
+
+    int getDelay() const { return delay; }
+
+    // audio thread: delays samples [start, start + n) of each channel in place, a copy in and a
+    // circular read out. Call snapSteps afterwards, while the ring still has the samples ahead.
+    void process(juce::AudioBuffer<float>& buffer, int start, int n, int numChannels)
+    {
+        CHRONOS_TRACE_SCOPE("Lookahead::process");
+        numChannels = juce::jmin(numChannels, ring.getNumChannels(), buffer.getNumChannels());
+        const int readPos = (writePos - delay + ringSize) & (ringSize - 1);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* data = buffer.getWritePointer(ch, start);
+            float* r = ring.getWritePointer(ch);
+
+            const int firstWrite = juce::jmin(n, ringSize - writePos);
+            juce::FloatVectorOperations::copy(r + writePos, data, firstWrite);
+            juce::FloatVectorOperations::copy(r, data + firstWrite, n - firstWrite);
+
+            const int firstRead = juce::jmin(n, ringSize - readPos);
+            juce::FloatVectorOperations::copy(data, r + readPos, firstRead);
+            juce::FloatVectorOperations::copy(data + firstRead, r, n - firstRead);
+        }
+
+        chunkReadPos = readPos;
+        chunkChannels = numChannels;
+        writePos = (writePos + n) & (ringSize - 1);
+    }
+
+    // audio thread: holds every big step in gain[0..n) back until the delayed audio it applies
+    // to crosses zero, if that happens within the lookahead. Curves without steps go
+    // through untouched apart from the one compare per sample.
+    void snapSteps(float* gain, int n)
+    {
+        if (lastGain < 0.0f)
+            lastGain = gain[0];
+
+        for (int i = 0; i < n; ++i)
+        {
+            if (holdLeft > 0)
+            {
+                if (--holdLeft > 0)
+                {
+                    gain[i] = heldGain;
+                    continue;
+                }
+
+                lastGain = gain[i]; // at the crossing: let the step through
+                continue;
+            }
+
+            if (std::abs(gain[i] - lastGain) > stepThreshold)
+            {
+                const int wait = samplesToZeroCrossing(i);
+                if (wait > 0)
+                {
+                    heldGain = lastGain;
+                    holdLeft = wait;
+                    gain[i] = heldGain;
+                    continue;
+                }
+            }
+
+            lastGain = gain[i];
+        }
+    }
+
+private:
+    juce::AudioBuffer<float> ring;
+    int ringSize = 1;
+    int delay = 0;
+    bool active = false;
+
+    // audio thread
+    int writePos = 0;
+    int chunkReadPos = 0, chunkChannels = 0;
+    float heldGain = 1.0f, lastGain = -1.0f;
+    int holdLeft = 0;
+
+    // delayed sample 'offset' of the current chunk (up to delay past its end), channels summed
+    float delayedAt(int offset) const
+    {
+        const int pos = (chunkReadPos + offset) & (ringSize - 1);
+        float sum = 0.0f;
+        for (int ch = 0; ch < chunkChannels; ++ch)
+            sum += ring.getSample(ch, pos);
+        return sum;
+    }
+
+    // how many samples from output offset i until the audio changes sign (0 = it's at zero
+    // now, or there's no crossing within the lookahead and the step goes through as it is)
+    int samplesToZeroCrossing(int i) const
+    {
+        const float first = delayedAt(i);
+        if (first == 0.0f)
+            return 0;
+
+        for (int d = 1; d <= delay; ++d)
+        {
+            const float x = delayedAt(i + d);
+            if (x == 0.0f || (x > 0.0f) != (first > 0.0f))
+                return d;
+        }
+        return 0;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Lookahead)
+};
@@ -0,0 +1,87 @@
+// MidSide.h
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cmath>
+#include <vector>
+#include "LFO.h"
+#include "Multiband.h"
+#include "Trace.h"
+
+// Gates mid and side of a stereo pair with their own depth, so the image can pump while the
+// centre stays put (or the other way round). The side curve can also run a phase offset
+// behind the mid one. Encode, both gains and decode happen in one pass over the two
+// channels, in place (a plain loop the compiler vectorises, no scratch copies):
+//   m = (l + r) * gainMid,  s = (l - r) * gainSide,  l = (m + s) / 2,  r = (m - s) / 2
+class MidSide
+{
+public:
+    // GUI writes, audio thread reads once per block
+    std::atomic<bool> enabled{ false };
+    std::atomic<float> midDepth{ 0.0f };   // 0..1 of the mix; 0 leaves the centre alone
+    std::atomic<float> sideDepth{ 1.0f };
+    std::atomic<float> sidePhase{ 0.0f };  // cycles behind the mid curve
+
+    void prepare(int maxBlockSize)
+    {
+        sideGain.assign((size_t)juce::jmax(1, maxBlockSize), 0.0f);
+    }
+
+    // audio thread: true if this block is processed as mid/side (needs exactly a stereo pair)
+    bool beginBlock(int numChannels)
+    {
+        if (!enabled.load(std::memory_order_relaxed) || numChannels != 2)
+            return false;
+
+        mid = juce::jlimit(0.0f, 1.0f, midDepth.load(std::memory_order_relaxed));
+        side = juce::jlimit(0.0f, 1.0f, sideDepth.load(std::memory_order_relaxed));
+        const float phase = sidePhase.load(std::memory_order_relaxed);
+        sideOffset = std::isfinite(phase) ? phase - std::floor(phase) : 0.0f;
+        return true;
+    }
+
+    // audio thread: 'curve' holds the 0..1 curve for the next n samples and becomes the mid
+    // gain; the side gain is made alongside it. With the stutter on the curve follows the
+    // slices, so the side offset (which follows the LFO) is left out.
+    void renderGains(float* curve, LFO& lfo, int n, float mix, float volume, const float* depthScale, bool followsLfo)
+    {
+        float* s = sideGain.data();
+        if (sideOffset != 0.0f && followsLfo)
+        {
+            lfo.renderAtPhases(s, n, 1, sideOffset);
+            juce::FloatVectorOperations::clip(s, s, 0.0f, 1.0f, n);
+        }
+        else
+        {
+            juce::FloatVectorOperations::copy(s, curve, n);
+        }
+
+        Multiband::lfoToGain(curve, n, mix * mid, volume, depthScale);
+        Multiband::lfoToGain(s, n, mix * side, volume, depthScale);
+    }
+
+    // audio thread: encode, gain and decode, in place
+    void process(juce::AudioBuffer<float>& buffer, int start, int n, const float* midGain)
+    {
+        CHRONOS_TRACE_SCOPE("MidSide::process");
+        float* l = buffer.getWritePointer(0, start);
+        float* r = buffer.getWritePointer(1, start);
+        const float* s = sideGain.data();
+
+        for (int i = 0; i < n; ++i)
+        {
+            const float m = (l[i] + r[i]) * midGain[i];
+            const float d = (l[i] - r[i]) * s[i];
+            l[i] = 0.5f * (m + d);
+            r[i] = 0.5f * (m - d);
+        }
+    }
+
+private:
+    std::vector<float> sideGain = std::vector<float>(512, 0.0f);
+
+    // per-block snapshot (audio thread)
+    float mid = 0.0f, side = 1.0f, sideOffset = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE(MidSide)
+};
@@ -0,0 +1,86 @@
+// MidSidePanel.h
+#pragma once
+#include <JuceHeader.h>
+#include "MidSide.h"
+
+// On/off, mid and side depth and the side's phase offset for the processor's MidSide.
+// Writes straight into its atomics; refresh() pulls them back after a state load.
+class MidSidePanel : public juce::Component
+{
+public:
+    explicit MidSidePanel(MidSide& midSideToEdit) : midSide(midSideToEdit)
+    {
+        mode.addItemList({ "Left/right", "Mid/side" }, 1);
+        mode.onChange = [this]() { midSide.enabled = mode.getSelectedId() == 2; };
+        addAndMakeVisible(mode);
+
+        style(midDepth);
+        midDepth.setRange(0.0, 100.0, 1.0);
+        midDepth.setTextValueSuffix("% mid depth");
+        midDepth.onValueChange = [this]() { midSide.midDepth = (float)midDepth.getValue() / 100.0f; };
+        addAndMakeVisible(midDepth);
+
+        style(sideDepth);
+        sideDepth.setRange(0.0, 100.0, 1.0);
+        sideDepth.setTextValueSuffix("% side depth");
+        sideDepth.onValueChange = [this]() { midSide.sideDepth = (float)sideDepth.getValue() / 100.0f; };
+        addAndMakeVisible(sideDepth);
+
+        style(sidePhase);
+        sidePhase.setRange(0.0, 359.0, 1.0);
+        sidePhase.setTextValueSuffix(juce::CharPointer_UTF8("\xc2\xb0 side phase"));
+        sidePhase.onValueChange = [this]() { midSide.sidePhase = (float)sidePhase.getValue() / 360.0f; };
+        addAndMakeVisible(sidePhase);
+
+        hint.setText("Stereo tracks only. With bands on, the bands take over.", juce::dontSendNotification);
+        hint.setFont(juce::Font(12.0f));
+        hint.setColour(juce::Label::textColourId, juce::Colours::grey);
+        hint.setJustificationType(juce::Justification::topLeft);
+        addAndMakeVisible(hint);
+
+        refresh();
+    }
+
+    void refresh()
+    {
+        mode.setSelectedId(midSide.enabled.load() ? 2 : 1, juce::dontSendNotification);
+        midDepth.setValue(midSide.midDepth.load() * 100.0, juce::dontSendNotification);
+        sideDepth.setValue(midSide.sideDepth.load() * 100.0, juce::dontSendNotification);
+        sidePhase.setValue(midSide.sidePhase.load() * 360.0, juce::dontSendNotification);
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.setColour(juce::Colour(30, 30, 34));
+        g.fillRoundedRectangle(getLocalBounds().toFloat(), 4.0f);
+    }
+
+    void resized() override
+    {
+        auto r = getLocalBounds().reduced(6);
+        for (juce::Component* c : { (juce::Component*)&mode, (juce::Component*)&midDepth,
+                                    (juce::Component*)&sideDepth, (juce::Component*)&sidePhase })
+        {
+            c->setBounds(r.removeFromTop(24));
+            r.removeFromTop(6);
+        }
+        hint.setBounds(r);
+    }
+
+private:
+    MidSide& midSide;
+
+    juce::ComboBox mode;
+    juce::Slider midDepth, sideDepth, sidePhase;
+    juce::Label hint;
+
+    static void style(juce::Slider& s)
+    {
+        s.setSliderStyle(juce::Slider::LinearBar);
+        s.setColour(juce::Slider::trackColourId, juce::Colour(35, 247, 176).withAlpha(0.6f));
+        s.setColour(juce::Slider::backgroundColourId, juce::Colour(44, 44, 49));
+        s.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(MidSidePanel)
+};
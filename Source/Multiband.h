@@ -0,0 +1,294 @@
+// Multiband.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "LFO.h"
+#include "Trace.h"
+
+// Splits the signal into 2-4 bands with Linkwitz-Riley (LR4) crossovers, gates each band
+// with its own copy of the LFO and sums them back. Lower bands go through an allpass for
+// every crossover above them, so with all depths at zero the sum is flat (just the LR4
+// phase shift). The filters run with one SIMD lane per channel: a stereo block costs the
+// same as a mono one.
+//
+// Settings are atomics the GUI writes; the audio thread reads them once per block in
+// beginBlock().
+class Multiband
+{
+public:
+    static constexpr int maxBands = 4;
+    static constexpr int maxChannels = 8;
+
+    struct Band
+    {
+        std::atomic<float> depth{ 1.0f };       // 0 = band left alone, 1 = full LFO
+        std::atomic<float> phaseOffset{ 0.0f }; // cycles, against the main LFO
+        std::atomic<int> rateMultiple{ 1 };     // 1..4 LFO cycles per main cycle
+    };
+
+    std::atomic<int> numBands{ 1 }; // 1 = whole spectrum, no filters
+    std::array<std::atomic<float>, maxBands - 1> crossoverHz;
+    std::array<Band, maxBands> bands;
+
+    Multiband()
+    {
+        crossoverHz[0] = 200.0f;
+        crossoverHz[1] = 2000.0f;
+        crossoverHz[2] = 8000.0f;
+    }
+
+    void prepare(double newSampleRate, int maxBlockSize)
+    {
+        sampleRate = newSampleRate;
+        const size_t size = (size_t)juce::jmax(1, maxBlockSize);
+        for (auto& g : gains)
+            g.assign(size, 0.0f);
+        interleaved.assign(size, Lanes::expand(0.0f));
+        reset();
+        coeffsHz.fill(-1.0f); // recalculated in the next beginBlock
+    }
+
+    void reset()
+    {
+        for (auto& group : states)
+        {
+            for (auto& s : group.split)
+                s.s1 = s.s2 = s.s3 = s.s4 = Lanes::expand(0.0f);
+            for (auto& row : group.allpass)
+                for (auto& s : row)
+                    s.s1 = s.s2 = Lanes::expand(0.0f);
+        }
+    }
+
+    // audio thread: picks up the settings for this block, returns how many bands are active
+    int beginBlock()
+    {
+        const int requested = juce::jlimit(1, maxBands, numBands.load(std::memory_order_relaxed));
+        if (requested != activeBands)
+        {
+            activeBands = requested;
+            reset(); // the tree is wired differently now, old state means nothing
+        }
+
+        // ascending, inside the audible range and clear of Nyquist
+        float lowest = 20.0f;
+        const float highest = (float)(sampleRate * 0.45);
+        for (int c = 0; c < maxBands - 1; ++c)
+        {
+            float hz = crossoverHz[(size_t)c].load(std::memory_order_relaxed);
+            hz = juce::jlimit(lowest, juce::jmax(lowest, highest), std::isfinite(hz) ? hz : lowest);
+            lowest = hz;
+
+            if (hz != coeffsHz[(size_t)c])
+            {
+                coeffsHz[(size_t)c] = hz;
+                coeffs[(size_t)c] = Coeffs::make(hz, sampleRate);
+            }
+        }
+
+        for (size_t b = 0; b < (size_t)maxBands; ++b)
+        {
+            depth[b] = juce::jlimit(0.0f, 1.0f, bands[b].depth.load(std::memory_order_relaxed));
+            phaseOffset[b] = bands[b].phaseOffset.load(std::memory_order_relaxed);
+            rateMultiple[b] = juce::jlimit(1, 4, bands[b].rateMultiple.load(std::memory_order_relaxed));
+        }
+
+        return activeBands;
+    }
+
+    // The plugin's gain law, in place: LFO values (0..1) in, gain out.
+    //   gain = volume * (1 - wet * scale * (1 - lfo))
+    // wet is mix times depth; depthScale (per sample, e.g. from the sidechain) may be null.
+    static void lfoToGain(float* g, int n, float wet, float volume, const float* depthScale)
+    {
+        if (depthScale == nullptr)
+        {
+            juce::FloatVectorOperations::multiply(g, wet * volume, n);
+            juce::FloatVectorOperations::add(g, (1.0f - wet) * volume, n);
+            return;
+        }
+
+        juce::FloatVectorOperations::multiply(g, -1.0f, n);
+        juce::FloatVectorOperations::add(g, 1.0f, n);
+        juce::FloatVectorOperations::multiply(g, depthScale, n);
+        juce::FloatVectorOperations::multiply(g, -wet * volume, n);
+        juce::FloatVectorOperations::add(g, volume, n);
+    }
+
+    // audio thread: per-band gain for the next n samples, from the LFO's last renderBlock,
+    // each band's depth scaling the mix
+    void renderGains(LFO& lfo, int n, float mix, float volume, const float* depthScale)
+    {
+        for (size_t b = 0; b < (size_t)activeBands; ++b)
+        {
+            float* g = gains[b].data();
+            if (depth[b] <= 0.0f)
+            {
+                juce::FloatVectorOperations::fill(g, volume, n);
+                continue;
+            }
+
+            lfo.renderAtPhases(g, n, rateMultiple[b], phaseOffset[b]);
+            juce::FloatVectorOperations::clip(g, g, 0.0f, 1.0f, n);
+            lfoToGain(g, n, mix * depth[b], volume, depthScale);
+        }
+    }
+
+    // audio thread: split, apply the gains from renderGains and sum back, in place
+    void process(juce::AudioBuffer<float>& buffer, int start, int n, int numChannels)
+    {
+        CHRONOS_TRACE_SCOPE("Multiband::process");
+        numChannels = juce::jmin(numChannels, buffer.getNumChannels(), maxChannels);
+
+        for (int group = 0; group * lanes < numChannels; ++group)
+        {
+            const int firstChannel = group * lanes;
+            const int groupChannels = juce::jmin(lanes, numChannels - firstChannel);
+
+            gather(buffer, start, n, firstChannel, groupChannels);
+            switch (activeBands)
+            {
+            case 2:  run<2>(states[(size_t)group], n); break;
+            case 3:  run<3>(states[(size_t)group], n); break;
+            default: run<4>(states[(size_t)group], n); break;
+            }
+            scatter(buffer, start, n, firstChannel, groupChannels);
+        }
+    }
+
+private:
+    using Lanes = juce::dsp::SIMDRegister<float>;
+    static constexpr int lanes = (int)Lanes::SIMDNumElements;
+    static constexpr int maxGroups = (maxChannels + lanes - 1) / lanes;
+
+    // TPT state-variable form (as in juce::dsp::LinkwitzRileyFilter), stable under modulation
+    struct Coeffs
+    {
+        Lanes g, h, r2, r2PlusG;
+
+        static Coeffs make(float hz, double sr)
+        {
+            const float gs = (float)std::tan(juce::MathConstants<double>::pi * hz / sr);
+            const float r2s = juce::MathConstants<float>::sqrt2;
+
+            Coeffs c;
+            c.g = Lanes::expand(gs);
+            c.h = Lanes::expand(1.0f / (1.0f + r2s * gs + gs * gs));
+            c.r2 = Lanes::expand(r2s);
+            c.r2PlusG = Lanes::expand(r2s + gs);
+            return c;
+        }
+    };
+
+    struct SplitState { Lanes s1, s2, s3, s4; };
+    struct AllpassState { Lanes s1, s2; };
+
+    struct GroupState
+    {
+        std::array<SplitState, maxBands - 1> split;
+        std::array<std::array<AllpassState, maxBands - 1>, maxBands - 1> allpass; // [band][crossover]
+    };
+
+    double sampleRate = 44100.0;
+    int activeBands = 1;
+
+    // per-block snapshot of the settings (audio thread)
+    std::array<float, maxBands> depth{}, phaseOffset{};
+    std::array<int, maxBands> rateMultiple{};
+    std::array<Coeffs, maxBands - 1> coeffs;
+    std::array<float, maxBands - 1> coeffsHz{};
+
+    std::array<GroupState, maxGroups> states;
+    std::array<std::vector<float>, maxBands> gains;
+    std::vector<Lanes> interleaved; // one register per sample frame, one lane per channel
+
+    // LR4 = two Butterworth sections in series. low + high is the 2nd order allpass, in phase
+    static forcedinline void split(const Coeffs& c, SplitState& s, Lanes x, Lanes& low, Lanes& high) noexcept
+    {
+        const Lanes yH = (x - c.r2PlusG * s.s1 - s.s2) * c.h;
+        const Lanes yB = c.g * yH + s.s1;
+        s.s1 = c.g * yH + yB;
+        const Lanes yL = c.g * yB + s.s2;
+        s.s2 = c.g * yB + yL;
+
+        const Lanes yH2 = (yL - c.r2PlusG * s.s3 - s.s4) * c.h;
+        const Lanes yB2 = c.g * yH2 + s.s3;
+        s.s3 = c.g * yH2 + yB2;
+        const Lanes yL2 = c.g * yB2 + s.s4;
+        s.s4 = c.g * yB2 + yL2;
+
+        low = yL2;
+        high = yL - c.r2 * yB + yH - yL2;
+    }
+
+    // the phase a crossover puts on everything that passes through it
+    static forcedinline Lanes allpass(const Coeffs& c, AllpassState& s, Lanes x) noexcept
+    {
+        const Lanes yH = (x - c.r2PlusG * s.s1 - s.s2) * c.h;
+        const Lanes yB = c.g * yH + s.s1;
+        s.s1 = c.g * yH + yB;
+        const Lanes yL = c.g * yB + s.s2;
+        s.s2 = c.g * yB + yL;
+        return yL - c.r2 * yB + yH;
+    }
+
+    // band b is the low side of crossover b (the last band is what's left above the top one)
+    // and then gets the allpass of every crossover above it
+    template <int numBandsToRun>
+    void run(GroupState& state, int n) noexcept
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            Lanes rest = interleaved[(size_t)i];
+            Lanes sum = Lanes::expand(0.0f);
+
+            for (int c = 0; c < numBandsToRun - 1; ++c)
+            {
+                Lanes low, high;
+                split(coeffs[(size_t)c], state.split[(size_t)c], rest, low, high);
+
+                for (int above = c + 1; above < numBandsToRun - 1; ++above)
+                    low = allpass(coeffs[(size_t)above], state.allpass[(size_t)c][(size_t)above], low);
+
+                sum += low * Lanes::expand(gains[(size_t)c][(size_t)i]);
+                rest = high;
+            }
+
+            interleaved[(size_t)i] = sum + rest * Lanes::expand(gains[(size_t)numBandsToRun - 1][(size_t)i]);
+        }
+    }
+
+    void gather(const juce::AudioBuffer<float>& buffer, int start, int n, int firstChannel, int numChannels)
+    {
+        auto* raw = reinterpret_cast<float*>(interleaved.data());
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            if (lane < numChannels)
+            {
+                const float* src = buffer.getReadPointer(firstChannel + lane, start);
+                for (int i = 0; i < n; ++i)
+                    raw[i * lanes + lane] = src[i];
+            }
+            else
+            {
+                for (int i = 0; i < n; ++i)
+                    raw[i * lanes + lane] = 0.0f; // spare lanes run on silence
+            }
+        }
+    }
+
+    void scatter(juce::AudioBuffer<float>& buffer, int start, int n, int firstChannel, int numChannels)
+    {
+        const auto* raw = reinterpret_cast<const float*>(interleaved.data());
+        for (int lane = 0; lane < numChannels; ++lane)
+        {
+            float* dest = buffer.getWritePointer(firstChannel + lane, start);
+            for (int i = 0; i < n; ++i)
+                dest[i] = raw[i * lanes + lane];
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Multiband)
+};
@@ -0,0 +1,179 @@
+// MultibandPanel.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "Multiband.h"
+
+// Band count, crossover frequencies and per-band depth / phase / rate for the processor's
+// Multiband. Writes straight into its atomics; refresh() pulls them back after a state load.
+class MultibandPanel : public juce::Component
+{
+public:
+    explicit MultibandPanel(Multiband& multibandToEdit) : multiband(multibandToEdit)
+    {
+        bandCount.addItemList({ "Full band", "2 bands", "3 bands", "4 bands" }, 1);
+        bandCount.onChange = [this]()
+        {
+            multiband.numBands = bandCount.getSelectedId();
+            updateVisibility();
+        };
+        addAndMakeVisible(bandCount);
+
+        for (size_t c = 0; c < crossovers.size(); ++c)
+        {
+            auto& s = crossovers[c];
+            style(s);
+            s.setRange(20.0, 20000.0, 1.0);
+            s.setSkewFactorFromMidPoint(1000.0);
+            s.setTextValueSuffix(" Hz");
+            s.onValueChange = [this, c]()
+            {
+                // keep them in order: dragging one past its neighbour pushes the neighbour along
+                multiband.crossoverHz[c] = (float)crossovers[c].getValue();
+                for (size_t above = c + 1; above < crossovers.size(); ++above)
+                    if (crossovers[above].getValue() < crossovers[above - 1].getValue())
+                        crossovers[above].setValue(crossovers[above - 1].getValue());
+                for (size_t below = c; below-- > 0;)
+                    if (crossovers[below].getValue() > crossovers[below + 1].getValue())
+                        crossovers[below].setValue(crossovers[below + 1].getValue());
+            };
+            addAndMakeVisible(s);
+        }
+
+        for (auto* l : { &depthHeader, &phaseHeader, &rateHeader })
+        {
+            l->setFont(juce::Font(12.0f));
+            l->setColour(juce::Label::textColourId, juce::Colours::grey);
+            l->setJustificationType(juce::Justification::centred);
+            addAndMakeVisible(l);
+        }
+
+        for (size_t b = 0; b < rows.size(); ++b)
+        {
+            auto& row = rows[b];
+            auto& band = multiband.bands[b];
+
+            row.name.setText(juce::String((int)b + 1), juce::dontSendNotification);
+            row.name.setColour(juce::Label::textColourId, juce::Colour(35, 247, 176));
+            row.name.setJustificationType(juce::Justification::centred);
+            addAndMakeVisible(row.name);
+
+            style(row.depth);
+            row.depth.setRange(0.0, 100.0, 1.0);
+            row.depth.setTextValueSuffix("%");
+            row.depth.onValueChange = [&row, &band]() { band.depth = (float)row.depth.getValue() / 100.0f; };
+            addAndMakeVisible(row.depth);
+
+            style(row.phase);
+            row.phase.setRange(0.0, 359.0, 1.0);
+            row.phase.setTextValueSuffix(juce::CharPointer_UTF8("\xc2\xb0"));
+            row.phase.onValueChange = [&row, &band]() { band.phaseOffset = (float)row.phase.getValue() / 360.0f; };
+            addAndMakeVisible(row.phase);
+
+            row.rate.addItemList({ "x1", "x2", "x3", "x4" }, 1);
+            row.rate.onChange = [&row, &band]() { band.rateMultiple = row.rate.getSelectedId(); };
+            addAndMakeVisible(row.rate);
+        }
+
+        refresh();
+    }
+
+    // pull every control from the processor (e.g. after a state/preset load)
+    void refresh()
+    {
+        bandCount.setSelectedId(juce::jlimit(1, Multiband::maxBands, multiband.numBands.load()), juce::dontSendNotification);
+        for (size_t c = 0; c < crossovers.size(); ++c)
+            crossovers[c].setValue(multiband.crossoverHz[c].load(), juce::dontSendNotification);
+
+        for (size_t b = 0; b < rows.size(); ++b)
+        {
+            auto& band = multiband.bands[b];
+            rows[b].depth.setValue(band.depth.load() * 100.0, juce::dontSendNotification);
+            rows[b].phase.setValue(band.phaseOffset.load() * 360.0, juce::dontSendNotification);
+            rows[b].rate.setSelectedId(juce::jlimit(1, 4, band.rateMultiple.load()), juce::dontSendNotification);
+        }
+
+        updateVisibility();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.setColour(juce::Colour(30, 30, 34));
+        g.fillRoundedRectangle(getLocalBounds().toFloat(), 4.0f);
+    }
+
+    void resized() override
+    {
+        auto r = getLocalBounds().reduced(6);
+
+        auto top = r.removeFromTop(24);
+        bandCount.setBounds(top.removeFromLeft(84));
+        top.removeFromLeft(4);
+        const int crossoverWidth = top.getWidth() / (int)crossovers.size();
+        for (auto& s : crossovers)
+            s.setBounds(top.removeFromLeft(crossoverWidth).reduced(2, 0));
+
+        r.removeFromTop(6);
+        auto header = r.removeFromTop(16);
+        header.removeFromLeft(nameWidth);
+        const int columnWidth = (header.getWidth() - rateWidth) / 2;
+        depthHeader.setBounds(header.removeFromLeft(columnWidth));
+        phaseHeader.setBounds(header.removeFromLeft(columnWidth));
+        rateHeader.setBounds(header);
+
+        const int rowHeight = juce::jmin(26, r.getHeight() / (int)rows.size());
+        for (auto& row : rows)
+        {
+            auto line = r.removeFromTop(rowHeight).reduced(0, 2);
+            row.name.setBounds(line.removeFromLeft(nameWidth));
+            row.depth.setBounds(line.removeFromLeft(columnWidth).reduced(2, 0));
+            row.phase.setBounds(line.removeFromLeft(columnWidth).reduced(2, 0));
+            row.rate.setBounds(line.reduced(2, 0));
+        }
+    }
+
+private:
+    static constexpr int nameWidth = 20, rateWidth = 52;
+
+    struct Row
+    {
+        juce::Label name;
+        juce::Slider depth, phase;
+        juce::ComboBox rate;
+    };
+
+    Multiband& multiband;
+
+    juce::ComboBox bandCount;
+    std::array<juce::Slider, Multiband::maxBands - 1> crossovers;
+    juce::Label depthHeader{ {}, "depth" }, phaseHeader{ {}, "phase" }, rateHeader{ {}, "rate" };
+    std::array<Row, Multiband::maxBands> rows;
+
+    static void style(juce::Slider& s)
+    {
+        s.setSliderStyle(juce::Slider::LinearBar);
+        s.setColour(juce::Slider::trackColourId, juce::Colour(35, 247, 176).withAlpha(0.6f));
+        s.setColour(juce::Slider::backgroundColourId, juce::Colour(44, 44, 49));
+        s.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+    }
+
+    // only the crossovers and rows in use; the rest would do nothing
+    void updateVisibility()
+    {
+        const int n = bandCount.getSelectedId();
+        for (size_t c = 0; c < crossovers.size(); ++c)
+            crossovers[c].setVisible((int)c < n - 1);
+        for (size_t b = 0; b < rows.size(); ++b)
+        {
+            const bool used = n > 1 && (int)b < n;
+            rows[b].name.setVisible(used);
+            rows[b].depth.setVisible(used);
+            rows[b].phase.setVisible(used);
+            rows[b].rate.setVisible(used);
+        }
+        for (auto* l : { &depthHeader, &phaseHeader, &rateHeader })
+            l->setVisible(n > 1);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(MultibandPanel)
+};
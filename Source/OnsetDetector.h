@@ -0,0 +1,135 @@
+// OnsetDetector.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include "Trace.h"
+
+// Finds transients in a stream so the LFO can restart on them. High-passed energy,
+// followed fast and slow: an onset is the fast envelope jumping above the slow one by
+// the sensitivity ratio. It then has to fall back under a lower ratio (hysteresis) and
+// the refractory time has to pass before the next one counts. One pass over the samples
+// as they arrive, no lookahead and no buffers, so it works while monitoring live.
+class OnsetDetector
+{
+public:
+    enum class Source { Off, Input, Sidechain };
+
+    static constexpr int maxOnsetsPerCall = 16; // the refractory time keeps it far below this
+
+    // GUI writes, audio thread reads once per block
+    std::atomic<int> source{ (int)Source::Off };
+    std::atomic<float> sensitivity{ 0.5f };    // 0..1, higher triggers on smaller hits
+    std::atomic<float> refractoryMs{ 80.0f };
+
+    // audio thread writes, GUI watches it to flash
+    std::atomic<juce::uint32> onsetCount{ 0 };
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        highPassCoeff = (float)std::exp(-juce::MathConstants<double>::twoPi * highPassHz / sampleRate);
+        fastCoeff = (float)std::exp(-1.0 / (sampleRate * 0.002)); // 2 ms
+        slowCoeff = (float)std::exp(-1.0 / (sampleRate * 0.150)); // 150 ms
+        reset();
+    }
+
+    void reset()
+    {
+        lastInput = lastHighPass = 0.0f;
+        fast = slow = 0.0f;
+        armed = true;
+        samplesSinceOnset = std::numeric_limits<int>::max();
+    }
+
+    // audio thread: which input to watch this block (Off if detection is off)
+    Source beginBlock()
+    {
+        const auto requested = (Source)juce::jlimit(0, 2, source.load(std::memory_order_relaxed));
+        if (requested != blockSource)
+            reset();
+        blockSource = requested;
+
+        // sensitivity 0..1 -> fast/slow ratio of 8 (only big hits) down to 1.5 (almost anything)
+        const float s = juce::jlimit(0.0f, 1.0f, sensitivity.load(std::memory_order_relaxed));
+        onRatio = juce::jmap(s, 8.0f, 1.5f);
+        offRatio = 1.0f + (onRatio - 1.0f) * 0.5f;
+
+        const float ms = refractoryMs.load(std::memory_order_relaxed);
+        refractorySamples = (int)(sampleRate * 0.001 * (std::isfinite(ms) ? juce::jlimit(10.0f, 1000.0f, ms) : 80.0f));
+        return blockSource;
+    }
+
+    // audio thread: scans samples [start, start + n) of 'input' (all its channels, mixed) and
+    // fills 'offsets' with where onsets begin, relative to start. Returns how many.
+    int process(const juce::AudioBuffer<float>& input, int numChannels, int start, int n,
+                std::array<int, maxOnsetsPerCall>& offsets)
+    {
+        CHRONOS_TRACE_SCOPE("OnsetDetector::process");
+        numChannels = juce::jmin(numChannels, input.getNumChannels());
+        if (numChannels <= 0)
+            return 0;
+
+        const float* channels[2] = { input.getReadPointer(0, start),
+                                     input.getReadPointer(numChannels > 1 ? 1 : 0, start) };
+        const float scale = numChannels > 1 ? 0.5f : 1.0f; // stereo (or the first two) to mono
+
+        int found = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            const float x = (channels[0][i] + channels[1][i]) * scale;
+
+            // one-pole high-pass, so sustained lows don't mask the attack
+            const float hp = highPassCoeff * (lastHighPass + x - lastInput);
+            lastInput = x;
+            lastHighPass = hp;
+
+            const float e = hp * hp;
+            fast = e + fastCoeff * (fast - e);
+            slow = e + slowCoeff * (slow - e);
+
+            if (samplesSinceOnset < refractorySamples)
+                ++samplesSinceOnset;
+            const float ratio = fast / (slow + floorEnergy);
+
+            if (armed)
+            {
+                if (ratio > onRatio && fast > floorEnergy && samplesSinceOnset >= refractorySamples)
+                {
+                    armed = false;
+                    samplesSinceOnset = 0;
+                    if (found < maxOnsetsPerCall)
+                        offsets[(size_t)found++] = i;
+                }
+            }
+            else if (ratio < offRatio)
+            {
+                armed = true;
+            }
+        }
+
+        if (found > 0)
+            onsetCount.fetch_add((juce::uint32)found, std::memory_order_relaxed);
+        return found;
+    }
+
+private:
+    static constexpr double highPassHz = 400.0;
+    static constexpr float floorEnergy = 1.0e-6f; // about -60 dBFS, quieter than this never triggers
+
+    double sampleRate = 44100.0;
+    float highPassCoeff = 0.0f, fastCoeff = 0.0f, slowCoeff = 0.0f;
+
+    // audio thread
+    Source blockSource = Source::Off;
+    float onRatio = 4.0f, offRatio = 2.5f;
+    int refractorySamples = 0;
+    float lastInput = 0.0f, lastHighPass = 0.0f;
+    float fast = 0.0f, slow = 0.0f;
+    bool armed = true;
+    int samplesSinceOnset = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(OnsetDetector)
+};
@@ -0,0 +1,163 @@
+// OutputMonitor.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define CHRONOS_MONITOR_SSE 1
+ #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+ #define CHRONOS_MONITOR_NEON 1
+ #include <arm_neon.h>
+#endif
+
+// What processBlock actually did, for the editor: per-channel peak/RMS of the output and a
+// decimated copy of the gain it applied. The audio thread does one vectorised pass over
+// each channel plus a strided read of the gain, and hands the results over through
+// lock-free FIFOs; the GUI only ever shows what it has received.
+class OutputMonitor
+{
+public:
+    static constexpr int maxChannels = 2;
+    static constexpr double scopePointsPerSecond = 1000.0;
+
+    struct Levels
+    {
+        std::array<float, maxChannels> peak{}, rms{};
+        int numChannels = 0;
+    };
+
+    void prepare(double sampleRate)
+    {
+        decimation = juce::jmax(1, juce::roundToInt(sampleRate / scopePointsPerSecond));
+        untilNextPoint = 0;
+    }
+
+    // audio thread: the gain about to be applied to n samples (called per render chunk)
+    void pushGain(const float* gain, int n)
+    {
+        int i = untilNextPoint;
+        if (i >= n)
+        {
+            untilNextPoint = i - n;
+            return;
+        }
+
+        const int count = 1 + (n - 1 - i) / decimation;
+        auto scope = scopeFifo.write(count); // drops what doesn't fit if the GUI isn't reading
+        for (int k = 0; k < scope.blockSize1; ++k, i += decimation)
+            scopePoints[(size_t)(scope.startIndex1 + k)] = gain[i];
+        for (int k = 0; k < scope.blockSize2; ++k, i += decimation)
+            scopePoints[(size_t)(scope.startIndex2 + k)] = gain[i];
+
+        // keep the stride steady across chunk and block boundaries
+        const int last = untilNextPoint + (count - 1) * decimation;
+        untilNextPoint = last + decimation - n;
+    }
+
+    // audio thread: peak and RMS of the processed block
+    void pushLevels(const juce::AudioBuffer<float>& buffer, int numChannels)
+    {
+        Levels levels;
+        levels.numChannels = juce::jmin(numChannels, maxChannels);
+        const int n = buffer.getNumSamples();
+        if (n <= 0)
+            return;
+
+        for (int ch = 0; ch < levels.numChannels; ++ch)
+        {
+            const float* data = buffer.getReadPointer(ch);
+            const auto range = juce::FloatVectorOperations::findMinAndMax(data, n);
+            levels.peak[(size_t)ch] = juce::jmax(std::abs(range.getStart()), std::abs(range.getEnd()));
+            levels.rms[(size_t)ch] = std::sqrt(sumOfSquares(data, n) / (float)n);
+        }
+
+        auto scope = levelFifo.write(1);
+        if (scope.blockSize1 > 0)
+            levelBlocks[(size_t)scope.startIndex1] = levels;
+        else if (scope.blockSize2 > 0)
+            levelBlocks[(size_t)scope.startIndex2] = levels;
+    }
+
+    // GUI: everything since the last call folded together (peak of peaks, RMS over the
+    // blocks); returns false if nothing new arrived
+    bool popLevels(Levels& result)
+    {
+        const int ready = levelFifo.getNumReady();
+        if (ready == 0)
+            return false;
+
+        result = {};
+        std::array<float, maxChannels> power{};
+        auto fold = [&](const Levels& l)
+        {
+            result.numChannels = juce::jmax(result.numChannels, l.numChannels);
+            for (size_t ch = 0; ch < (size_t)l.numChannels; ++ch)
+            {
+                result.peak[ch] = juce::jmax(result.peak[ch], l.peak[ch]);
+                power[ch] += l.rms[ch] * l.rms[ch];
+            }
+        };
+
+        auto scope = levelFifo.read(ready);
+        for (int i = 0; i < scope.blockSize1; ++i) fold(levelBlocks[(size_t)(scope.startIndex1 + i)]);
+        for (int i = 0; i < scope.blockSize2; ++i) fold(levelBlocks[(size_t)(scope.startIndex2 + i)]);
+
+        for (size_t ch = 0; ch < maxChannels; ++ch)
+            result.rms[ch] = std::sqrt(power[ch] / (float)ready);
+        return true;
+    }
+
+    // GUI: copies out up to maxPoints gain values, oldest first
+    int popScope(float* dest, int maxPoints)
+    {
+        auto scope = scopeFifo.read(juce::jmin(maxPoints, scopeFifo.getNumReady()));
+        std::copy_n(scopePoints.begin() + scope.startIndex1, scope.blockSize1, dest);
+        std::copy_n(scopePoints.begin() + scope.startIndex2, scope.blockSize2, dest + scope.blockSize1);
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    // sum of x^2, four lanes at a time where the platform has them
+    static float sumOfSquares(const float* data, int n)
+    {
+        int i = 0;
+        float total = 0.0f;
+
+       #if CHRONOS_MONITOR_SSE
+        __m128 acc = _mm_setzero_ps();
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m128 x = _mm_loadu_ps(data + i);
+            acc = _mm_add_ps(acc, _mm_mul_ps(x, x));
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, acc);
+        total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+       #elif CHRONOS_MONITOR_NEON
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        for (; i + 4 <= n; i += 4)
+        {
+            const float32x4_t x = vld1q_f32(data + i);
+            acc = vmlaq_f32(acc, x, x);
+        }
+        total = (vgetq_lane_f32(acc, 0) + vgetq_lane_f32(acc, 1)) + (vgetq_lane_f32(acc, 2) + vgetq_lane_f32(acc, 3));
+       #endif
+
+        for (; i < n; ++i)
+            total += data[i] * data[i];
+        return total;
+    }
+
+private:
+    juce::AbstractFifo levelFifo{ 64 };
+    std::array<Levels, 64> levelBlocks{};
+
+    juce::AbstractFifo scopeFifo{ 8192 };
+    std::array<float, 8192> scopePoints{};
+
+    int decimation = 48;
+    int untilNextPoint = 0; // audio thread: samples to skip before the next scope point
+};
@@ -0,0 +1,115 @@
+// OutputView.h
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include "OutputMonitor.h"
+
+// Output meters (peak bar with an RMS bar inside, per channel) next to a scrolling scope
+// of the gain processBlock really applied. Only draws what came through the monitor's
+// FIFOs, so a stalled or bypassed processor shows as a flat/empty scope, not the ideal curve.
+class OutputView : public juce::Component,
+                   private juce::Timer
+{
+public:
+    explicit OutputView(OutputMonitor& monitorToShow) : monitor(monitorToShow)
+    {
+        history.assign((size_t)historySize, -1.0f); // -1: nothing received yet
+        incoming.resize((size_t)historySize);
+        setInterceptsMouseClicks(false, false);
+        startTimerHz(30);
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        auto r = getLocalBounds().toFloat();
+        g.setColour(juce::Colour(30, 30, 34));
+        g.fillRoundedRectangle(r, 4.0f);
+
+        // meters on the left
+        auto meters = r.removeFromLeft(26.0f).reduced(4.0f, 4.0f);
+        const int numBars = juce::jmax(1, numChannels);
+        const float barWidth = meters.getWidth() / (float)numBars;
+        for (int ch = 0; ch < numBars; ++ch)
+        {
+            auto bar = meters.withX(meters.getX() + barWidth * (float)ch).withWidth(barWidth - 2.0f);
+            g.setColour(juce::Colour(44, 44, 49));
+            g.fillRect(bar);
+
+            g.setColour(peak[(size_t)ch] >= 1.0f ? juce::Colour(238, 99, 82) : juce::Colour(35, 247, 176).withAlpha(0.45f));
+            g.fillRect(bar.withTop(bar.getBottom() - bar.getHeight() * toMeter(peak[(size_t)ch])));
+            g.setColour(juce::Colour(35, 247, 176));
+            g.fillRect(bar.withTop(bar.getBottom() - bar.getHeight() * toMeter(rms[(size_t)ch])));
+        }
+
+        // gain scope, newest on the right
+        auto scope = r.reduced(4.0f, 4.0f);
+        g.setColour(juce::Colours::grey.withAlpha(0.25f));
+        g.drawHorizontalLine((int)scope.getCentreY(), scope.getX(), scope.getRight());
+
+        juce::Path p;
+        bool drawing = false;
+        for (int i = 0; i < historySize; ++i)
+        {
+            const float v = history[(size_t)((writePos + i) % historySize)];
+            if (v < 0.0f)
+            {
+                drawing = false;
+                continue;
+            }
+
+            const juce::Point<float> pt{ scope.getX() + scope.getWidth() * (float)i / (float)(historySize - 1),
+                                         scope.getBottom() - scope.getHeight() * juce::jlimit(0.0f, 1.0f, v) };
+            if (drawing)
+                p.lineTo(pt);
+            else
+                p.startNewSubPath(pt);
+            drawing = true;
+        }
+
+        g.setColour(juce::Colour(40, 246, 177));
+        g.strokePath(p, juce::PathStrokeType(1.5f));
+    }
+
+private:
+    static constexpr int historySize = 2000; // two seconds at the monitor's 1000 points/s
+
+    OutputMonitor& monitor;
+    int numChannels = 0;
+    std::array<float, OutputMonitor::maxChannels> peak{}, rms{}; // what the meters show
+
+    std::vector<float> history, incoming; // ring of scope points, and a pull buffer
+    int writePos = 0;
+
+    // -60..0 dBFS onto 0..1
+    static float toMeter(float gain)
+    {
+        return juce::jlimit(0.0f, 1.0f, (juce::Decibels::gainToDecibels(gain, -60.0f) + 60.0f) / 60.0f);
+    }
+
+    void timerCallback() override
+    {
+        // new levels if any came in; otherwise the meters fall, about 40 dB a second
+        OutputMonitor::Levels fresh;
+        const bool received = monitor.popLevels(fresh);
+        if (received)
+            numChannels = fresh.numChannels;
+
+        bool changed = received;
+        for (size_t ch = 0; ch < peak.size(); ++ch)
+        {
+            peak[ch] = juce::jmax(fresh.peak[ch], peak[ch] * 0.85f);
+            rms[ch] = received ? fresh.rms[ch] : rms[ch] * 0.85f;
+            changed = changed || peak[ch] > 0.0005f;
+        }
+
+        const int n = monitor.popScope(incoming.data(), historySize);
+        for (int i = 0; i < n; ++i)
+        {
+            history[(size_t)writePos] = incoming[(size_t)i];
+            writePos = (writePos + 1) % historySize;
+        }
+
+        if (changed || n > 0)
+            repaint();
+    }
+};
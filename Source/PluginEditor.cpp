@@ -15,13 +15,12 @@
 
 
 
-WaveformEditor waveEditor;  
 //GlowEffect volumeGlow;
 //==============================================================================
 
 
 LFO2AudioProcessorEditor::LFO2AudioProcessorEditor (LFO2AudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p),
+    : AudioProcessorEditor (&p), audioProcessor (p), presetBrowser (p.getPresetBank()), loadHud (p.loadMeter), outputView (p.outputMonitor), spectrumView (p.spectrumTap), multibandPanel (p.multiband), sidechainPanel (p.sidechain, p.onsets, [&p]() { return p.isSidechainConnected(); }), stutterPanel (p.stutter), midSidePanel (p.midSide), stepGatePanel (p.stepGate), sequencerPanel (p.shapeSequencer, [&p]() { return p.getCurve(); }, [&p](bool on) { p.setShapeSequencerEnabled(on); }),
     volumeGlow(&midiVolume, juce::Colours::cyan, 25.0f, true, GlowEffect::Mode::HueCycle, 1.5f)
 {
     startTimerHz(30);
@@ -99,14 +98,14 @@ LFO2AudioProcessorEditor::LFO2AudioProcessorEditor (LFO2AudioProcessor& p)
         {
             hzButton.setToggleState(false, juce::dontSendNotification);
             bpmHzButton.setToggleState(false, juce::dontSendNotification);
-            audioProcessor.currentMode = LFO2AudioProcessor::RateMode::BPM;
+            displayedMode = LFO2AudioProcessor::RateMode::BPM;
 
-            // Convert Hz → division
-            float currentHz = audioProcessor.lfo.getRateHz();
+            // the processor converts Hz → division itself at the next block, this is just the preview
+            audioProcessor.requestRateMode(LFO2AudioProcessor::RateMode::BPM);
+            float currentHz = audioProcessor.getLFORateHz();
             float bpm = audioProcessor.bpm;
-            float division = (bpm / 60.0f) / currentHz;
-            audioProcessor.division = division;
-            updateTimeSliderFromDivision();
+            float division = LFO2AudioProcessor::nearestBpmDivision((bpm / 60.0f) / currentHz);
+            updateTimeSliderFromDivision(division);
         }
     };
 
@@ -115,19 +114,17 @@ LFO2AudioProcessorEditor::LFO2AudioProcessorEditor (LFO2AudioProcessor& p)
         {
             bpmButton.setToggleState(false, juce::dontSendNotification);
             bpmHzButton.setToggleState(false, juce::dontSendNotification);
-            audioProcessor.currentMode = LFO2AudioProcessor::RateMode::HZ;
+            displayedMode = LFO2AudioProcessor::RateMode::HZ;
 
-
-            float hz = (audioProcessor.bpm / 60.0f) / audioProcessor.division;
+            // processor keeps the playing rate when it applies the switch
+            audioProcessor.requestRateMode(LFO2AudioProcessor::RateMode::HZ);
+            float hz = audioProcessor.getLFORateHz();
 
             // Set up slider
             timeSlider.setRange(0.1, 15.0, 0.01);
             timeSlider.setValue(hz, juce::dontSendNotification);
             timeValueLabel.setText(juce::String(hz, 2) + " Hz", juce::dontSendNotification);
 
-            // Actually set the LFO to Hz rate
-            audioProcessor.currentHz = hz;
-            audioProcessor.lfo.setRateHz(hz);
             waveEditor.setAnimationSpeed(hz);
         }
     };
@@ -135,19 +132,98 @@ LFO2AudioProcessorEditor::LFO2AudioProcessorEditor (LFO2AudioProcessor& p)
     bpmHzButton.onClick = [this]() {
         if (bpmHzButton.getToggleState())
         {
-            float hz = (audioProcessor.bpm / 60.0f) / audioProcessor.division;
+            float hz = audioProcessor.getLFORateHz();
 
             bpmButton.setToggleState(false, juce::dontSendNotification);
             hzButton.setToggleState(false, juce::dontSendNotification);
-            audioProcessor.currentMode = LFO2AudioProcessor::RateMode::BPM_HZ;
+            displayedMode = LFO2AudioProcessor::RateMode::BPM_HZ;
+            audioProcessor.requestRateMode(LFO2AudioProcessor::RateMode::BPM_HZ);
 
-            timeSlider.setRange(0.1, 15.0, 0.01);
-            timeSlider.setValue(audioProcessor.lfo.getRateHz(), juce::dontSendNotification);
-            timeValueLabel.setText(juce::String(hz, 2) + " Hz", juce::dontSendNotification);  //TODO NOT WORKING 
+            // slider is a 0..1 position here, divisions evenly spaced (see divisionPositions)
+            timeSlider.setRange(0.0, 1.0, 0.001);
+            timeSlider.setValue(hzToPosition(hz, audioProcessor.bpm), juce::dontSendNotification);
+            timeValueLabel.setText(juce::String(hz, 2) + " Hz", juce::dontSendNotification);
 
         }
     };
 
+    // how long a snap takes to glide back onto the host grid
+    glideSlider.setSliderStyle(juce::Slider::LinearBar);
+    glideSlider.setColour(juce::Slider::trackColourId, juce::Colour(35, 247, 176).withAlpha(0.6f));
+    glideSlider.setColour(juce::Slider::backgroundColourId, juce::Colour(44, 44, 49));
+    glideSlider.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+    glideSlider.addListener(this);
+    addAndMakeVisible(glideSlider);
+
+    glideUnitButton.setLookAndFeel(&customLAF);
+    glideUnitButton.setColour(juce::TextButton::textColourOffId, juce::Colour(35, 247, 176));
+    glideUnitButton.setColour(juce::TextButton::buttonColourId, juce::Colour(44, 44, 49));
+    glideUnitButton.onClick = [this]()
+    {
+        // swap units, keep roughly the same length at the current tempo
+        const bool toBeats = !audioProcessor.snapGlideInBeats.load();
+        const float beatMs = 60000.0f / juce::jmax(1.0f, audioProcessor.bpm.load());
+        const float amount = audioProcessor.snapGlide.load();
+
+        audioProcessor.snapGlide = toBeats ? amount / beatMs : amount * beatMs;
+        audioProcessor.snapGlideInBeats = toBeats;
+        updateGlideControls();
+    };
+    addAndMakeVisible(glideUnitButton);
+
+    // spectrum on/off; the FFT worker only runs while it's showing
+    spectrumButton.setLookAndFeel(&customLAF);
+    spectrumButton.setClickingTogglesState(true);
+    spectrumButton.setColour(juce::TextButton::textColourOffId, juce::Colour(35, 247, 176));
+    spectrumButton.setColour(juce::TextButton::buttonColourId, juce::Colour(44, 44, 49));
+    spectrumButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(35, 247, 176).withAlpha(0.35f));
+    spectrumButton.onClick = [this]()
+    {
+        spectrumView.setVisible(spectrumButton.getToggleState());
+        resized();
+    };
+    addAndMakeVisible(spectrumButton);
+    addChildComponent(spectrumView);
+
+    // band split / sidechain / stutter / mid-side / step gate / sequencer settings take the preset browser's place while one is on
+    for (auto* b : { &bandsButton, &sidechainButton, &stutterButton, &midSideButton, &stepGateButton, &sequencerButton })
+    {
+        b->setLookAndFeel(&customLAF);
+        b->setClickingTogglesState(true);
+        b->setColour(juce::TextButton::textColourOffId, juce::Colour(35, 247, 176));
+        b->setColour(juce::TextButton::buttonColourId, juce::Colour(44, 44, 49));
+        b->setColour(juce::TextButton::buttonOnColourId, juce::Colour(35, 247, 176).withAlpha(0.35f));
+        addAndMakeVisible(b);
+    }
+    for (auto* b : { &bandsButton, &sidechainButton, &stutterButton, &midSideButton, &stepGateButton, &sequencerButton })
+    {
+        b->onClick = [this, b]()
+        {
+            // one panel at a time
+            if (b->getToggleState())
+                for (auto* other : { &bandsButton, &sidechainButton, &stutterButton, &midSideButton, &stepGateButton, &sequencerButton })
+                    if (other != b)
+                        other->setToggleState(false, juce::dontSendNotification);
+            updateLowerPanel();
+        };
+    }
+    addChildComponent(multibandPanel);
+    addChildComponent(sidechainPanel);
+    addChildComponent(stutterPanel);
+    addChildComponent(midSidePanel);
+    addChildComponent(stepGatePanel);
+    addChildComponent(sequencerPanel);
+
+    // delays the audio a few ms so hard gates open right on the transient, without clicks
+    lookaheadButton.setLookAndFeel(&customLAF);
+    lookaheadButton.setClickingTogglesState(true);
+    lookaheadButton.setColour(juce::TextButton::textColourOffId, juce::Colour(35, 247, 176));
+    lookaheadButton.setColour(juce::TextButton::buttonColourId, juce::Colour(44, 44, 49));
+    lookaheadButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(35, 247, 176).withAlpha(0.35f));
+    lookaheadButton.setToggleState(audioProcessor.lookahead.enabled.load(), juce::dontSendNotification);
+    lookaheadButton.onClick = [this]() { audioProcessor.setLookahead(lookaheadButton.getToggleState()); };
+    addAndMakeVisible(lookaheadButton);
+
     //----------------------------------------------------------
 
 
@@ -189,13 +265,43 @@ LFO2AudioProcessorEditor::LFO2AudioProcessorEditor (LFO2AudioProcessor& p)
 
 
     addAndMakeVisible(waveEditor);
-    // When editor updates waveform, push it into audio LFO (audioProcessor.lfo)
-    waveEditor.setUpdateCallback([this](const std::vector<float>& buf)
+    // every edit goes straight to the processor's bake thread (which coalesces drags),
+    // so nothing waits for a timer and the GUI never bakes
+    waveEditor.setUpdateCallback([this](const Curve& edited)
         {
-            // This is GUI thread calling into processor — safe because LFO uses CriticalSection
-            audioProcessor.lfo.setCustomWaveform(buf);
+            // drawing over a random shape means the drawn curve is wanted again
+            if (LFO::isRandom(audioProcessor.lfo.getShape()))
+            {
+                audioProcessor.lfo.setShape(LFO::Shape::Custom);
+                lfoShapeSelector.setSelectedId(0, juce::dontSendNotification);
+            }
+            audioProcessor.curveEdited(edited, editingCurveB);
         });
 
+    // A/B morph: pick which curve gets drawn, the slider blends between them
+    for (auto* b : { &curveAButton, &curveBButton })
+    {
+        b->setClickingTogglesState(true);
+        b->setRadioGroupId(2);
+        b->setLookAndFeel(&customLAF);
+        b->setColour(juce::TextButton::textColourOffId, juce::Colour(35, 247, 176));
+        b->setColour(juce::TextButton::textColourOnId, juce::Colour(63, 63, 68));
+        b->setColour(juce::TextButton::buttonOnColourId, juce::Colour(35, 247, 176));
+        b->setColour(juce::TextButton::buttonColourId, juce::Colour(44, 44, 49));
+        addAndMakeVisible(b);
+    }
+    curveAButton.setToggleState(true, juce::dontSendNotification);
+    curveAButton.onClick = [this]() { if (curveAButton.getToggleState()) selectCurve(false); };
+    curveBButton.onClick = [this]() { if (curveBButton.getToggleState()) selectCurve(true); };
+
+    morphSlider.setSliderStyle(juce::Slider::LinearBar);
+    morphSlider.setTextValueSuffix(" Morph");
+    morphSlider.setColour(juce::Slider::trackColourId, juce::Colour(35, 247, 176).withAlpha(0.6f));
+    morphSlider.setColour(juce::Slider::backgroundColourId, juce::Colour(44, 44, 49));
+    morphSlider.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+    morphAttachment = std::make_unique<juce::SliderParameterAttachment>(*audioProcessor.morphParam, morphSlider);
+    addAndMakeVisible(morphSlider);
+
 
     // Text above LFO selector 
     lfoShapeLabel.setText("LFO Shape", juce::dontSendNotification);
@@ -209,28 +315,62 @@ LFO2AudioProcessorEditor::LFO2AudioProcessorEditor (LFO2AudioProcessor& p)
     lfoShapeSelector.addItem("Triangle", 3);
     lfoShapeSelector.addItem("Square", 4);
     //lfoShapeSelector.addItem("Custom", 5);
+    lfoShapeSelector.addItem("Random S&H", 6);
+    lfoShapeSelector.addItem("Random smooth", 7);
     lfoShapeSelector.setSelectedId(1); // default to saw for now 
     lfoShapeSelector.onChange = [this]()
     {
         int selected = lfoShapeSelector.getSelectedId();
-        std::string shapeName;
         LFO::Shape shape = LFO::Shape::Saw;
 
         switch (selected)
         {
-        case 1: shape = LFO::Shape::Saw; shapeName = "Saw"; break;
-        case 2: shape = LFO::Shape::Sine; shapeName = "Sine"; break;
-        case 3: shape = LFO::Shape::Triangle; shapeName = "Triangle"; break;
-        case 4: shape = LFO::Shape::Square; shapeName = "Square"; break;
+        case 1: shape = LFO::Shape::Saw; break;
+        case 2: shape = LFO::Shape::Sine; break;
+        case 3: shape = LFO::Shape::Triangle; break;
+        case 4: shape = LFO::Shape::Square; break;
         //case 5: shape = LFO::Shape::Custom; break;
+        case 6: shape = LFO::Shape::RandomStep; break;
+        case 7: shape = LFO::Shape::RandomSmooth; break;
         }
 
         audioProcessor.lfo.setShape(shape);
 
-        waveEditor.setPresetWaveform(shapeName);
+        // random shapes have no curve to draw, the drawn one stays put for later
+        if (!LFO::isRandom(shape))
+            waveEditor.setPresetWaveform(shape);
     };
     addAndMakeVisible(lfoShapeSelector);
 
+    for (auto* s : { &humanizeSlider, &seedSlider })
+    {
+        s->setSliderStyle(juce::Slider::LinearBar);
+        s->setColour(juce::Slider::trackColourId, juce::Colour(35, 247, 176).withAlpha(0.6f));
+        s->setColour(juce::Slider::backgroundColourId, juce::Colour(44, 44, 49));
+        s->setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+        s->valueFromTextFunction = [](const juce::String& text) { return text.retainCharacters("0123456789.").getDoubleValue(); };
+        addAndMakeVisible(s);
+    }
+    humanizeSlider.textFromValueFunction = [](double v) { return "Humanize " + juce::String((int)v) + "%"; };
+    humanizeSlider.setRange(0.0, 100.0, 1.0);
+    humanizeSlider.setValue(audioProcessor.humanize.load() * 100.0, juce::dontSendNotification);
+    humanizeSlider.onValueChange = [this]() { audioProcessor.humanize = (float)humanizeSlider.getValue() / 100.0f; };
+
+    seedSlider.textFromValueFunction = [](double v) { return "Seed " + juce::String((int)v); };
+    seedSlider.setRange(0.0, 999.0, 1.0);
+    seedSlider.setValue(audioProcessor.randomSeed.load(), juce::dontSendNotification);
+    seedSlider.onValueChange = [this]() { audioProcessor.randomSeed = (int)seedSlider.getValue(); };
+
+
+    // user preset bank
+    presetBrowser.onPresetChosen = [this](int index)
+    {
+        audioProcessor.loadPreset(index);
+        syncFromProcessor();
+    };
+    presetBrowser.onSave = [this](const juce::String& name) { audioProcessor.savePreset(name); };
+    addAndMakeVisible(presetBrowser);
+
 
     //logo stuff 
 
@@ -239,9 +379,16 @@ LFO2AudioProcessorEditor::LFO2AudioProcessorEditor (LFO2AudioProcessor& p)
     addAndMakeVisible(logoImage);
 
 
-    //bpmButton.
+    // DSP load overlay, added last so it sits on top when opened
+    loadHud.onExpandedChanged = [this]() { resized(); };
+    addAndMakeVisible(loadHud);
+
+    addAndMakeVisible(outputView);
 
+    //bpmButton.
 
+    seenStateLoads = audioProcessor.stateLoads.load();
+    syncFromProcessor();
 }
 
 
@@ -251,6 +398,17 @@ LFO2AudioProcessorEditor::~LFO2AudioProcessorEditor() {
     bpmButton.setLookAndFeel(nullptr);  //supposed to clean look and feel shit
     hzButton.setLookAndFeel(nullptr);
     bpmHzButton.setLookAndFeel(nullptr);
+    curveAButton.setLookAndFeel(nullptr);
+    curveBButton.setLookAndFeel(nullptr);
+    glideUnitButton.setLookAndFeel(nullptr);
+    spectrumButton.setLookAndFeel(nullptr);
+    bandsButton.setLookAndFeel(nullptr);
+    sidechainButton.setLookAndFeel(nullptr);
+    stutterButton.setLookAndFeel(nullptr);
+    midSideButton.setLookAndFeel(nullptr);
+    stepGateButton.setLookAndFeel(nullptr);
+    sequencerButton.setLookAndFeel(nullptr);
+    lookaheadButton.setLookAndFeel(nullptr);
 
 }
 
@@ -258,6 +416,7 @@ LFO2AudioProcessorEditor::~LFO2AudioProcessorEditor() {
 //==============================================================================
 void LFO2AudioProcessorEditor::paint (juce::Graphics& g) //paint is called very often so dont put anything crazy in here 
 {
+    CHRONOS_TRACE_SCOPE("LFO2AudioProcessorEditor::paint");
 
     
     
@@ -395,7 +554,7 @@ void LFO2AudioProcessorEditor::paint (juce::Graphics& g) //paint is called very
 
 
 
-    if (audioProcessor.currentMode == LFO2AudioProcessor::RateMode::BPM_HZ)
+    if (displayedMode == LFO2AudioProcessor::RateMode::BPM_HZ)
     {
         if (timeValueLabel.getText().contains("/"))
             timeValueLabel.setColour(juce::Label::textColourId, juce::Colour(238, 99, 82));
@@ -427,12 +586,20 @@ void LFO2AudioProcessorEditor::resized()
 
 
 
-    waveEditor.setBounds(getWidth() / 2 + 20, 125, getWidth() / 2 - 40, getHeight() - 140);
+    auto waveArea = juce::Rectangle<int>(getWidth() / 2 + 20, 125, getWidth() / 2 - 40, getHeight() - 140);
+    if (spectrumView.isVisible())
+        spectrumView.setBounds(waveArea.removeFromBottom(140).withTrimmedTop(8));
+    waveEditor.setBounds(waveArea);
 
     //dropdown
     auto topArea = getLocalBounds().removeFromTop(80);
     lfoShapeLabel.setBounds(getWidth() / 2 +10, 60, 300, 30);
     lfoShapeSelector.setBounds(getWidth() / 2 + 15, 90, 100, 25);
+    humanizeSlider.setBounds(getWidth() / 2 + 120, 64, 150, 22);
+    seedSlider.setBounds(getWidth() / 2 + 275, 64, 70, 22); // clear of the mix knob
+    curveAButton.setBounds(getWidth() / 2 + 125, 90, 28, 25);
+    curveBButton.setBounds(getWidth() / 2 + 157, 90, 28, 25);
+    morphSlider.setBounds(getWidth() / 2 + 195, 90, getWidth() / 2 - 215, 25);
 
 
     //rate to hz 
@@ -440,10 +607,36 @@ void LFO2AudioProcessorEditor::resized()
     bpmButton.setBounds(210, 110, buttonWidth, buttonHeight);
     hzButton.setBounds(210, 140, buttonWidth, buttonHeight);
     bpmHzButton.setBounds(210, 170, buttonWidth, buttonHeight);
+    glideSlider.setBounds(270, 110, 115, buttonHeight);
+    glideUnitButton.setBounds(270, 140, 50, buttonHeight);
+    spectrumButton.setBounds(325, 140, 60, buttonHeight);
+    bandsButton.setBounds(270, 170, 55, buttonHeight);
+    sidechainButton.setBounds(330, 170, 55, buttonHeight);
+    // mode panels, a tighter column so it stays clear of the output meters
+    stutterButton.setBounds(210, 200, 38, 22);
+    midSideButton.setBounds(210, 223, 38, 22);
+    stepGateButton.setBounds(210, 246, 38, 22);
+    sequencerButton.setBounds(210, 269, 38, 22);
+    lookaheadButton.setBounds(105, 250, 90, buttonHeight); // under the division knob
 
 
     logoImage.setBounds(-10, 5, 80, 80);
 
+    presetBrowser.setBounds(105, 360, 280, 180); // sits inside rectangle 2
+    multibandPanel.setBounds(presetBrowser.getBounds());
+    sidechainPanel.setBounds(presetBrowser.getBounds());
+    stutterPanel.setBounds(presetBrowser.getBounds());
+    midSidePanel.setBounds(presetBrowser.getBounds());
+    stepGatePanel.setBounds(presetBrowser.getBounds());
+    sequencerPanel.setBounds(presetBrowser.getBounds());
+
+    outputView.setBounds(95, 292, 300, 52); // in the gap between the two rectangles
+
+    // bottom right corner, grows up and left when opened
+    const int hudW = loadHud.isExpanded() ? LoadHud::expandedWidth : LoadHud::collapsedWidth;
+    const int hudH = loadHud.isExpanded() ? LoadHud::expandedHeight : LoadHud::collapsedHeight;
+    loadHud.setBounds(getWidth() - hudW - 8, getHeight() - hudH - 6, hudW, hudH);
+
 }
 
 //should be whats fitting the slider data to the global volume
@@ -451,56 +644,57 @@ void LFO2AudioProcessorEditor::sliderValueChanged(juce::Slider* slider) {
     if (slider == &midiVolume) {
         audioProcessor.globalVolume = (float)midiVolume.getValue();
     }
+    else if (slider == &glideSlider) {
+        audioProcessor.snapGlide = (float)glideSlider.getValue();
+    }
     else if (slider == &mixKnob) {
         audioProcessor.mix = (float)mixKnob.getValue(), juce::dontSendNotification;
     }
     else if (slider == &timeSlider)
     {
         
-       if (audioProcessor.currentMode == LFO2AudioProcessor::RateMode::BPM) {
+       if (displayedMode == LFO2AudioProcessor::RateMode::BPM) {
        
         int selection = (int)timeSlider.getValue();
+        float newDivision = audioProcessor.division;
 
         switch (selection)
         {
         case 1:
-            audioProcessor.division = 16;  
+            newDivision = 16;  
             timeValueLabel.setText("1/16", juce::dontSendNotification);
             break;
         case 2:
-            audioProcessor.division = 4;
+            newDivision = 4;
             timeValueLabel.setText("1/8", juce::dontSendNotification);
             break;
         case 3:
-            audioProcessor.division = 1;
+            newDivision = 1;
             timeValueLabel.setText("1/4", juce::dontSendNotification);
             break;
         case 4:
-            audioProcessor.division = 0.5;
+            newDivision = 0.5;
             timeValueLabel.setText("1/2", juce::dontSendNotification);  
             break;
         case 5:
-            audioProcessor.division = 0.25;
+            newDivision = 0.25;
             timeValueLabel.setText("1/4", juce::dontSendNotification);  
             break;
         }
-        audioProcessor.lfo.setRate(audioProcessor.bpm, audioProcessor.division);
-        float newRateHz = audioProcessor.getLFORateHz();
-        waveEditor.setAnimationSpeed(newRateHz);
+        audioProcessor.requestDivision(newDivision);
+        waveEditor.setAnimationSpeed(bpmDivisionToHz(audioProcessor.bpm, newDivision));
         }
     
-    else if (audioProcessor.currentMode == LFO2AudioProcessor::RateMode::HZ) //switching between buttons 
+    else if (displayedMode == LFO2AudioProcessor::RateMode::HZ) //switching between buttons 
     {
         float hz = (float)timeSlider.getValue();
         timeValueLabel.setText(juce::String(hz, 2) + " Hz", juce::dontSendNotification);
-        audioProcessor.lfo.setSampleRate(audioProcessor.getSampleRate());
-        
-        audioProcessor.currentHz = hz;  
-        audioProcessor.currentMode = LFO2AudioProcessor::RateMode::HZ;
+
+        audioProcessor.requestHz(hz);
 
         waveEditor.setAnimationSpeed(hz);
     } 
-    else if (audioProcessor.currentMode == LFO2AudioProcessor::RateMode::BPM_HZ) //bpm/hz mode 
+    else if (displayedMode == LFO2AudioProcessor::RateMode::BPM_HZ) //bpm/hz mode 
        {
            float pos = (float)timeSlider.getValue();   
            float bpm = audioProcessor.bpm;
@@ -508,6 +702,7 @@ void LFO2AudioProcessorEditor::sliderValueChanged(juce::Slider* slider) {
            float snapThreshold = 0.02f; // Tweak for lock in feature higher is bigger lock/ snap 
            float snappedPos = pos;
            bool snapped = false;
+           float snappedDivision = 0.0f;
            juce::String closestLabel;
 
            for (auto& [divisionPos, divisionVal] : divisionPositions)
@@ -515,6 +710,7 @@ void LFO2AudioProcessorEditor::sliderValueChanged(juce::Slider* slider) {
                if (std::abs(pos - divisionPos) < snapThreshold)
                {
                    snappedPos = divisionPos;
+                   snappedDivision = divisionVal;
                    snapped = true;
                    
                    for (auto& div : divisions) // need to find closest label
@@ -536,9 +732,12 @@ void LFO2AudioProcessorEditor::sliderValueChanged(juce::Slider* slider) {
            // convert to hz 
            float hzValue = positionToHz(snappedPos, bpm);
 
-           //Update LFO and animation speed
-           //audioProcessor.lfo.setRate(bpm, (bpm / 60.0f) / hzValue);
-           audioProcessor.currentHz = pos;
+           // on a division the processor locks to the host grid and glides onto it,
+           // anywhere else it's a free Hz rate
+           if (snapped)
+               audioProcessor.requestSnap(snappedDivision);
+           else
+               audioProcessor.requestHz(hzValue);
            waveEditor.setAnimationSpeed(hzValue);
 
            // label updating 
@@ -553,6 +752,15 @@ void LFO2AudioProcessorEditor::sliderValueChanged(juce::Slider* slider) {
 
 void LFO2AudioProcessorEditor::timerCallback()
 {
+    CHRONOS_TRACE_SCOPE("LFO2AudioProcessorEditor::timerCallback");
+
+    // the host loaded a state while we were open
+    if (const auto loads = audioProcessor.stateLoads.load(); loads != seenStateLoads)
+    {
+        seenStateLoads = loads;
+        syncFromProcessor();
+    }
+
     float lfoRateHz = audioProcessor.getLFORateHz();  // expose a getter from your processor
     waveEditor.setAnimationSpeed(lfoRateHz);
 
@@ -563,13 +771,11 @@ void LFO2AudioProcessorEditor::timerCallback()
 
 //helper for updating slider into BPM
 
-void LFO2AudioProcessorEditor::updateTimeSliderFromDivision()
+void LFO2AudioProcessorEditor::updateTimeSliderFromDivision(float division)
 {
-    if (audioProcessor.currentMode == LFO2AudioProcessor::RateMode::BPM)
+    if (displayedMode == LFO2AudioProcessor::RateMode::BPM)
     {
         timeSlider.setRange(1, 5, 1);
-
-        float division = audioProcessor.division;
         int sliderValue = 1;
         juce::String text = "1/16";
 
@@ -585,6 +791,87 @@ void LFO2AudioProcessorEditor::updateTimeSliderFromDivision()
 }
 
 
+void LFO2AudioProcessorEditor::syncFromProcessor()
+{
+    midiVolume.setValue(audioProcessor.globalVolume, juce::dontSendNotification);
+    mixKnob.setValue(audioProcessor.mix, juce::dontSendNotification);
+
+    auto shape = audioProcessor.lfo.getShape();
+    if (shape != LFO::Shape::Custom)
+        lfoShapeSelector.setSelectedId((int)shape + 1, juce::dontSendNotification);
+    humanizeSlider.setValue(audioProcessor.humanize.load() * 100.0, juce::dontSendNotification);
+    seedSlider.setValue(audioProcessor.randomSeed.load(), juce::dontSendNotification);
+
+    waveEditor.setCurve(editingCurveB ? audioProcessor.getCurveB() : audioProcessor.getCurve());
+
+    // the requested rate if a restore is still queued, the live one otherwise
+    const auto rate = audioProcessor.getRateStateForDisplay();
+    auto mode = rate.mode;
+    displayedMode = mode;
+    bpmButton.setToggleState(mode == LFO2AudioProcessor::RateMode::BPM, juce::dontSendNotification);
+    hzButton.setToggleState(mode == LFO2AudioProcessor::RateMode::HZ, juce::dontSendNotification);
+    bpmHzButton.setToggleState(mode == LFO2AudioProcessor::RateMode::BPM_HZ, juce::dontSendNotification);
+
+    if (mode == LFO2AudioProcessor::RateMode::BPM)
+    {
+        updateTimeSliderFromDivision(rate.division);
+    }
+    else
+    {
+        float hz = rate.hz;
+        if (mode == LFO2AudioProcessor::RateMode::BPM_HZ)
+        {
+            timeSlider.setRange(0.0, 1.0, 0.001);
+            timeSlider.setValue(hzToPosition(hz, audioProcessor.bpm), juce::dontSendNotification);
+        }
+        else
+        {
+            timeSlider.setRange(0.1, 15.0, 0.01);
+            timeSlider.setValue(hz, juce::dontSendNotification);
+        }
+        timeValueLabel.setText(juce::String(hz, 2) + " Hz", juce::dontSendNotification);
+    }
+
+    updateGlideControls();
+    multibandPanel.refresh();
+    sidechainPanel.refresh();
+    stutterPanel.refresh();
+    midSidePanel.refresh();
+    stepGatePanel.refresh();
+    sequencerPanel.refresh();
+    lookaheadButton.setToggleState(audioProcessor.lookahead.enabled.load(), juce::dontSendNotification);
+}
+
+void LFO2AudioProcessorEditor::updateLowerPanel()
+{
+    multibandPanel.setVisible(bandsButton.getToggleState());
+    sidechainPanel.setVisible(sidechainButton.getToggleState());
+    stutterPanel.setVisible(stutterButton.getToggleState());
+    midSidePanel.setVisible(midSideButton.getToggleState());
+    stepGatePanel.setVisible(stepGateButton.getToggleState());
+    sequencerPanel.setVisible(sequencerButton.getToggleState());
+
+    bool anyPanel = false;
+    for (auto* b : { &bandsButton, &sidechainButton, &stutterButton, &midSideButton, &stepGateButton, &sequencerButton })
+        anyPanel = anyPanel || b->getToggleState();
+    presetBrowser.setVisible(!anyPanel);
+}
+
+void LFO2AudioProcessorEditor::updateGlideControls()
+{
+    const bool inBeats = audioProcessor.snapGlideInBeats.load();
+    glideSlider.setRange(0.0, inBeats ? 4.0 : 2000.0, inBeats ? 0.25 : 10.0);
+    glideSlider.setTextValueSuffix(inBeats ? " beats glide" : " ms glide");
+    glideSlider.setValue(audioProcessor.snapGlide.load(), juce::dontSendNotification);
+    glideUnitButton.setButtonText(inBeats ? "beats" : "ms");
+}
+void LFO2AudioProcessorEditor::selectCurve(bool curveB)
+{
+    editingCurveB = curveB;
+    curveAButton.setToggleState(!curveB, juce::dontSendNotification);
+    curveBButton.setToggleState(curveB, juce::dontSendNotification);
+    waveEditor.setCurve(curveB ? audioProcessor.getCurveB() : audioProcessor.getCurve());
+}
 
 float LFO2AudioProcessorEditor::positionToHz(float pos, float bpm) //conversion helper functions 
 {
@@ -625,7 +912,8 @@ float LFO2AudioProcessorEditor::hzToPosition(float hz, float bpm)
         }
     }
 
-    return 0.0f;
+    // off either end of the range
+    return hz > bpmDivisionToHz(bpm, divisionPositions.rbegin()->second) ? 1.0f : 0.0f;
 }
 
 
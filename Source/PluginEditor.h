@@ -13,13 +13,21 @@
 #include "WaveFormEditor.h"
 #include "GlowEffect.h"
 #include "CustomLookAndFeel.h"
+#include "PresetBrowser.h"
+#include "LoadHud.h"
+#include "OutputView.h"
+#include "SpectrumView.h"
+#include "MultibandPanel.h"
+#include "SidechainPanel.h"
+#include "StutterPanel.h"
+#include "MidSidePanel.h"
+#include "StepGatePanel.h"
+#include "ShapeSequencerPanel.h"
 
 //==============================================================================
 /**
 */
 
-extern WaveformEditor waveEditor; //idk if this works 
-
 class ImageKnob : public juce::Slider
 {
 public:
@@ -68,7 +76,10 @@ public:
     void paint (juce::Graphics&) override;
     //void paintOverChildren(juce::Graphics& g);
     void resized() override;
-    void updateTimeSliderFromDivision();
+    void updateTimeSliderFromDivision(float division);
+    void syncFromProcessor(); // pull restored state into the controls
+    void selectCurve(bool curveB); // which of the A/B morph curves the editor draws
+    void updateGlideControls(); // range/units of the snap glide slider
 
 
 
@@ -86,6 +97,17 @@ private:
     // access the processor object that created it.
     LFO2AudioProcessor& audioProcessor;
 
+    PresetBrowser presetBrowser;
+    LoadHud loadHud;
+    OutputView outputView; // meters + what the gain really did
+    SpectrumView spectrumView; // in vs out, shares the wave editor's space when on
+    MultibandPanel multibandPanel; // swaps in for the preset browser
+    SidechainPanel sidechainPanel; // likewise
+    StutterPanel stutterPanel;     // and again
+    MidSidePanel midSidePanel;     // and again
+    StepGatePanel stepGatePanel;   // and again
+    ShapeSequencerPanel sequencerPanel; // and again
+
     juce::Slider midiVolume; //slider thing
     juce::Slider timeSlider;   //time stamp slider 
     juce::Slider mixKnob;   //time stamp slider 
@@ -100,6 +122,10 @@ private:
     juce::ComboBox lfoShapeSelector;
     juce::Label lfoShapeLabel;
 
+    // random shapes: per-cycle jitter and the seed they play from
+    juce::Slider humanizeSlider;
+    juce::Slider seedSlider;
+
     void sliderValueChanged(juce::Slider* slider) override;
 
     void timerCallback() override;
@@ -109,10 +135,37 @@ private:
     juce::TextButton hzButton{ "Hz" };
     juce::TextButton bpmHzButton{ "BPM/Hz" };
 
+    // snap-back glide length, in ms or beats
+    juce::Slider glideSlider;
+    juce::TextButton glideUnitButton{ "ms" };
+
+    juce::TextButton spectrumButton{ "FFT" };
+    juce::TextButton bandsButton{ "Bands" };
+    juce::TextButton sidechainButton{ "SC" };
+    juce::TextButton stutterButton{ "Stut" };
+    juce::TextButton midSideButton{ "M/S" };
+    juce::TextButton stepGateButton{ "Step" };
+    juce::TextButton sequencerButton{ "Seq" };
+    juce::TextButton lookaheadButton{ "Lookahead" };
+    void updateLowerPanel(); // presets or one of the mode panels in rectangle 2
+
+    // A/B morph
+    juce::TextButton curveAButton{ "A" };
+    juce::TextButton curveBButton{ "B" };
+    juce::Slider morphSlider;
+    std::unique_ptr<juce::SliderParameterAttachment> morphAttachment;
+    bool editingCurveB = false;
+
+    // mode shown by the buttons; the processor catches up at its next block
+    LFO2AudioProcessor::RateMode displayedMode = LFO2AudioProcessor::RateMode::BPM;
+    juce::uint32 seenStateLoads = 0; // processor's stateLoads at the last sync
+
     juce::Font titleFont; // futuristic font 
 
     juce::ImageComponent logoImage;
 
+    WaveformEditor waveEditor; // one per editor, a shared one could only sit in one window
+
 
     GlowEffect volumeGlow; //for glow 
 
@@ -18,6 +18,9 @@ LFO2AudioProcessor::LFO2AudioProcessor()
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                      #if ! JucePlugin_IsSynth
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
+                      #endif
                      #endif
                        )
 #endif
@@ -26,13 +29,19 @@ LFO2AudioProcessor::LFO2AudioProcessor()
     division = 1.0f;
     mix = 1.0f;
     globalVolume = 1.0f;
-    usingTestAudio = false;
 
-    formatManager.registerBasicFormats();
+    addParameter(morphParam = new juce::AudioParameterFloat(juce::ParameterID{ "morph", 1 }, "Morph", 0.0f, 1.0f, 0.0f));
+
+    eventLogWriter->add(eventLog);
 }
 
 LFO2AudioProcessor::~LFO2AudioProcessor()
 {
+    eventLogWriter->remove(eventLog);
+
+    // a pending bake would write into our LFO (or sequencer) after we're gone
+    curveBaker->cancel(lfo);
+    curveBaker->cancel(shapeSequencer);
 }
 
 //==============================================================================
@@ -99,34 +108,39 @@ void LFO2AudioProcessor::changeProgramName (int index, const juce::String& newNa
 
 void LFO2AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock) //only daw functionality 
 {
-    juce::ignoreUnused(samplesPerBlock);
-
     if (sampleRate <= 0.0)
         sampleRate = 44100.0;
 
-    formatManager.registerBasicFormats();
-    lfo.setSampleRate(sampleRate);
+    lfo.prepare(sampleRate, samplesPerBlock);
+    loadMeter.prepare(sampleRate);
+    outputMonitor.prepare(sampleRate);
+    spectrumTap.prepare(sampleRate);
     lfo.reset();
+    gainBuffer.assign((size_t)juce::jmax(1, samplesPerBlock), 0.0f);
+    multiband.prepare(sampleRate, samplesPerBlock);
+    sidechain.prepare(sampleRate, samplesPerBlock);
+    onsets.prepare(sampleRate);
+    lookahead.prepare(sampleRate, samplesPerBlock, juce::jmax(getMainBusNumInputChannels(), getTotalNumOutputChannels()));
+    setLatencySamples(lookahead.enabled.load() ? lookahead.getDelay() : 0);
+    stutter.prepare(sampleRate, samplesPerBlock, getMainBusNumOutputChannels()); // mono or stereo, see isBusesLayoutSupported
+    midSide.prepare(samplesPerBlock);
+    stepGate.prepare(sampleRate);
+    shapeSequencer.prepare(sampleRate);
 
     //safety vals 
-    bpm = std::isfinite(bpm) && bpm > 0.0f ? bpm : 120.0f;
-    division = std::isfinite(division) && division > 0.0f ? division : 1.0f;
+    const float hostBpm = bpm.load();
+    bpm = std::isfinite(hostBpm) && hostBpm > 0.0f ? hostBpm : 120.0f;
+    const float currentDivision = division.load();
+    division = std::isfinite(currentDivision) && currentDivision > 0.0f ? currentDivision : 1.0f;
+    applyRateCommands(); // the audio thread isn't running yet, so catch up on anything posted meanwhile
     mix = juce::jlimit(0.0f, 1.0f, mix);
     globalVolume = std::max(0.0f, globalVolume);
-
-    //Completely remove test audio no standalone test audio loading
-    usingTestAudio = false;
-    readerSource = nullptr;
-    transportSource.releaseResources();
-
 }
 
 void LFO2AudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
-    transportSource.releaseResources(); 
-
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -148,6 +162,16 @@ bool LFO2AudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) con
    #if ! JucePlugin_IsSynth
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
+
+    // optional sidechain: off, mono or stereo
+    if (layouts.inputBuses.size() > 1)
+    {
+        const auto sidechainSet = layouts.getChannelSet(true, 1);
+        if (!sidechainSet.isDisabled()
+         && sidechainSet != juce::AudioChannelSet::mono()
+         && sidechainSet != juce::AudioChannelSet::stereo())
+            return false;
+    }
    #endif
 
     return true;
@@ -157,62 +181,213 @@ bool LFO2AudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) con
 
 void LFO2AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    CHRONOS_TRACE_THREAD("audio");
+    CHRONOS_TRACE_SCOPE("processBlock");
+    DspLoadMeter::ScopedTimer loadTimer(loadMeter, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels = getTotalNumInputChannels();
+    auto totalNumInputChannels = getMainBusNumInputChannels(); // the sidechain is read separately
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
     if (getSampleRate() <= 0.0)
+    {
+        eventLog.push(EventLog::Type::NotPrepared);
         return;
+    }
+
+    spectrumTap.push(SpectrumTap::input, buffer, totalNumInputChannels); // no-op unless the spectrum is open
 
     // Remove test audio block entirely
 
-    // bpm from host 
+    // bpm (and the ppq the grid sync needs) from host 
+    float hostBpm = bpm.load();
+    juce::Optional<juce::AudioPlayHead::PositionInfo> position;
     if (auto* playHead = getPlayHead())
+        position = playHead->getPosition();
+
+    eventLog.beginBlock(position && position->getTimeInSamples() ? *position->getTimeInSamples() : -1);
+
+    if (position && position->getBpm() && *position->getBpm() > 0.0)
+        hostBpm = (float)*position->getBpm();
+
+    if (!std::isfinite(hostBpm) || hostBpm <= 0.0f)
     {
-        juce::AudioPlayHead::CurrentPositionInfo info;
-        if (playHead->getCurrentPosition(info) && info.bpm > 0.0)
-            bpm = (float)info.bpm;
+        eventLog.push(EventLog::Type::SanityCheck, (int)EventLog::Value::HostBpm, hostBpm, 120.0f);
+        hostBpm = 120.0f;
     }
+    if (std::abs(hostBpm - bpm.load()) > 0.001f)
+        eventLog.push(EventLog::Type::TempoChange, 0, bpm.load(), hostBpm);
+    bpm = hostBpm;
 
-    if (!std::isfinite(bpm) || bpm <= 0.0f)
-        bpm = 120.0f;
-    if (!std::isfinite(division) || division <= 0.0f)
-        division = 1.0f;
     if (!std::isfinite(mix))
+    {
+        eventLog.push(EventLog::Type::SanityCheck, (int)EventLog::Value::Mix, mix, 1.0f);
         mix = 1.0f;
+    }
     if (!std::isfinite(globalVolume))
+    {
+        eventLog.push(EventLog::Type::SanityCheck, (int)EventLog::Value::Volume, globalVolume, 1.0f);
         globalVolume = 1.0f;
+    }
+
+    // mode/rate changes land here, all at once, at the block boundary. The phase is never
+    // set here; if a change puts us off the grid, updateGridSync glides back onto it.
+    applyRateCommands();
+
+    float blockDivision = division.load();
+    if (!std::isfinite(blockDivision) || blockDivision <= 0.0f)
+    {
+        eventLog.push(EventLog::Type::SanityCheck, (int)EventLog::Value::Division, blockDivision, 1.0f);
+        division = blockDivision = 1.0f;
+    }
 
-    switch (currentMode)
+    switch (currentMode.load())
     {
     case RateMode::BPM:
-        lfo.setRate(bpm, division);
+        lfo.setRate(hostBpm, blockDivision);
         break;
 
     case RateMode::HZ:
         //lfo.setRate(60.0f * currentHz, 1.0f); // or store a member variable for Hz
-        lfo.setRateHz(currentHz);
+        lfo.setRateHz(currentHz.load());
         break;
 
     case RateMode::BPM_HZ:
-        lfo.setRateHz(currentHz); // or whichever mapping you want
+        if (gridLocked)
+            lfo.setRate(hostBpm, blockDivision); // snapped onto a division
+        else
+            lfo.setRateHz(currentHz.load());
         break;
     }
+    playingHz.store(lfo.getRateHz(), std::memory_order_relaxed);
 
-    for (int channel = 0; channel < totalNumOutputChannels; ++channel) //should work outside the master now
+    const auto onsetSource = onsets.beginBlock();
+    retriggering = onsetSource != OnsetDetector::Source::Off;
+    updateGridSync(position, buffer.getNumSamples(), hostBpm, blockDivision);
+
+    lfo.setMorph(morphParam->get());
+    lfo.setHumanize(humanize.load());
+
+    if (gainBuffer.empty())
+        return;
+
+    const int numSamples = buffer.getNumSamples();
+    const int maxChunk = (int)gainBuffer.size();
+    const int numBands = multiband.beginBlock();
+    const bool midSideActive = numBands == 1 && midSide.beginBlock(totalNumOutputChannels); // bands win
+
+    // no channels if the host hasn't connected it
+    auto sidechainBuffer = getBusCount(true) > 1 ? getBusBuffer(buffer, true, 1) : juce::AudioBuffer<float>();
+    const bool sidechainActive = sidechain.beginBlock(sidechainBuffer.getNumChannels());
+    const bool lookingAhead = lookahead.beginBlock();
+    const bool stuttering = stutter.beginBlock(position, numSamples, hostBpm, lookingAhead ? lookahead.getDelay() : 0);
+    const bool stepGating = stepGate.beginBlock(position, numSamples, hostBpm);
+    const bool sequencing = shapeSequencer.beginBlock(position, numSamples, hostBpm);
+
+    // one LFO step per sample frame, shared by every channel (stepping it per channel
+    // used to run stereo at twice the rate and put the channels out of phase)
+    for (int start = 0; start < numSamples; start += maxChunk)
     {
-        auto* samples = buffer.getWritePointer(channel);
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        const int n = juce::jmin(maxChunk, numSamples - start);
+        auto* gain = gainBuffer.data();
+
+        // transients in this chunk restart the LFO on their exact sample (before the gain is
+        // applied and before the lookahead delay, so with lookahead on the restart lands early)
+        if (retriggering)
+        {
+            const bool fromSidechain = onsetSource == OnsetDetector::Source::Sidechain;
+            std::array<int, OnsetDetector::maxOnsetsPerCall> onsetOffsets;
+            const int found = onsets.process(fromSidechain ? sidechainBuffer : buffer,
+                                             fromSidechain ? sidechainBuffer.getNumChannels() : totalNumInputChannels,
+                                             start, n, onsetOffsets);
+            for (int i = 0; i < found; ++i)
+                lfo.retriggerAt(onsetOffsets[(size_t)i]);
+        }
+
+        // the gate and the sequencer write the whole gain themselves, so the LFO only
+        // has to keep its phase going (for the bands, and for when they're turned off)
+        const bool lfoOwnsGain = !stepGating && !sequencing;
+        if (lfoOwnsGain)
+            lfo.renderBlock(gain, n);
+        else
+            lfo.advance(n);
+        if (sequencing)
+            shapeSequencer.render(gain, n); // the bar's slot instead of the LFO (bands keep the LFO)
+        juce::FloatVectorOperations::clip(gain, gain, 0.0f, 1.0f, n);
+
+        // the gain stays on time and the audio goes late, so every edge arrives early
+        if (lookingAhead)
+            lookahead.process(buffer, start, n, totalNumOutputChannels);
+
+        // the repeats come out of the (delayed) audio, and the drawn curve follows the slices
+        // instead of the LFO rate. Bands keep the LFO.
+        if (stuttering)
         {
-            float lfoValue = lfo.getNextSample();
-            float lfoGain = juce::jlimit(0.0f, 1.0f, juce::jmap(lfoValue, 0.0f, 1.0f, 0.0f, 1.0f));
-            float gain = (1.0f - mix) + (mix * lfoGain);
-            samples[i] *= gain * globalVolume;
+            stutter.process(buffer, start, n, totalNumOutputChannels);
+            if (!stepGating)
+                stutter.renderEnvelope(lfo, gain, n);
         }
+
+        // the step pattern replaces the curve (over the stutter's slices too); bands keep the LFO
+        if (stepGating)
+            stepGate.render(gain, n);
+
+        const float* depthScale = sidechainActive ? sidechain.render(sidechainBuffer, start, n) : nullptr;
+        if (midSideActive)
+            midSide.renderGains(gain, lfo, n, mix, globalVolume, depthScale, !stuttering); // gain becomes the mid's
+        else
+            Multiband::lfoToGain(gain, n, mix, globalVolume, depthScale);
+
+        // (the stutter fades its own edges, and mid/side has two gains)
+        if (lookingAhead && numBands == 1 && !stuttering && !midSideActive)
+            lookahead.snapSteps(gain, n);
+        outputMonitor.pushGain(gain, n); // the main LFO's gain, also in multiband mode
+
+        if (numBands > 1)
+        {
+            multiband.renderGains(lfo, n, mix, globalVolume, depthScale);
+            multiband.process(buffer, start, n, totalNumOutputChannels);
+            continue;
+        }
+
+        if (midSideActive)
+        {
+            midSide.process(buffer, start, n, gain);
+            continue;
+        }
+
+        for (int channel = 0; channel < totalNumOutputChannels; ++channel) //should work outside the master now
+            juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel, start), gain, n);
     }
+
+    outputMonitor.pushLevels(buffer, totalNumOutputChannels);
+    spectrumTap.push(SpectrumTap::output, buffer, totalNumOutputChannels);
+
+    // tables the baker (or a preset load) published, as the audio thread picked them up
+    if (auto swaps = lfo.getCustomTableSwaps(); swaps != loggedCustomSwaps)
+    {
+        eventLog.push(EventLog::Type::TableSwap, 0, (float)(swaps - loggedCustomSwaps));
+        loggedCustomSwaps = swaps;
+    }
+    if (auto swaps = lfo.getMorphTableSwaps(); swaps != loggedMorphSwaps)
+    {
+        eventLog.push(EventLog::Type::TableSwap, 1, (float)(swaps - loggedMorphSwaps));
+        loggedMorphSwaps = swaps;
+    }
+}
+
+void LFO2AudioProcessor::setLookahead(bool shouldBeOn)
+{
+    lookahead.enabled = shouldBeOn;
+    setLatencySamples(shouldBeOn ? lookahead.getDelay() : 0);
+}
+
+bool LFO2AudioProcessor::isSidechainConnected() const
+{
+    auto* bus = getBus(true, 1);
+    return bus != nullptr && bus->isEnabled();
 }
 
 //==============================================================================
@@ -229,15 +404,632 @@ juce::AudioProcessorEditor* LFO2AudioProcessor::createEditor()
 //==============================================================================
 void LFO2AudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    // compact binary chunk: magic + version, the settings, then the curve as control points
+    // (not the baked table). Fields are only ever appended so older chunks keep loading.
+    juce::MemoryOutputStream out(destData, false);
+
+    out.writeInt(stateMagic);
+    out.writeShort((short)stateVersion);
+
+    // version 1
+    out.writeFloat(globalVolume);
+    out.writeFloat(mix);
+    out.writeFloat(division.load());
+    out.writeFloat(currentHz.load());
+    out.writeByte((char)currentMode.load());
+    out.writeByte((char)lfo.getShape());
+    out.writeBool(lfo.hasCustomWaveform());
+    getCurve().writeTo(out);
+
+    // version 2
+    out.writeFloat(morphParam->get());
+    out.writeBool(lfo.hasMorphWaveform());
+    getCurveB().writeTo(out);
+
+    // version 3
+    out.writeFloat(snapGlide.load());
+    out.writeBool(snapGlideInBeats.load());
+
+    // version 4
+    out.writeByte((char)multiband.numBands.load());
+    for (auto& hz : multiband.crossoverHz)
+        out.writeFloat(hz.load());
+    for (auto& band : multiband.bands)
+    {
+        out.writeFloat(band.depth.load());
+        out.writeFloat(band.phaseOffset.load());
+        out.writeByte((char)band.rateMultiple.load());
+    }
+
+    // version 5
+    out.writeFloat(sidechain.amount.load());
+    out.writeFloat(sidechain.attackMs.load());
+    out.writeFloat(sidechain.releaseMs.load());
+
+    // version 6
+    out.writeByte((char)onsets.source.load());
+    out.writeFloat(onsets.sensitivity.load());
+    out.writeFloat(onsets.refractoryMs.load());
+
+    // version 7
+    out.writeBool(lookahead.enabled.load());
+
+    // version 8
+    out.writeByte((char)stutter.mode.load());
+    out.writeByte((char)stutter.sliceDenominator.load());
+    out.writeByte((char)stutter.repeats.load());
+    out.writeBool(stutter.reverse.load());
+
+    // version 9
+    out.writeBool(midSide.enabled.load());
+    out.writeFloat(midSide.midDepth.load());
+    out.writeFloat(midSide.sideDepth.load());
+    out.writeFloat(midSide.sidePhase.load());
+
+    // version 10
+    const auto pattern = stepGate.getPattern();
+    out.writeBool(stepGate.enabled.load());
+    out.writeByte((char)pattern.numSteps);
+    for (const auto& step : pattern.steps)
+    {
+        out.writeFloat(step.level);
+        out.writeFloat(step.length);
+        out.writeBool(step.tie);
+    }
+
+    // version 11
+    const auto sequence = shapeSequencer.getSequence();
+    out.writeBool(shapeSequencer.enabled.load());
+    out.writeByte((char)sequence.numSlots);
+    for (const auto& slot : sequence.slots)
+    {
+        out.writeByte((char)slot.shape);
+        out.writeFloat(slot.cyclesPerBar);
+    }
+
+    // version 12
+    out.writeFloat(humanize.load());
+    out.writeInt(randomSeed.load());
 }
 
 void LFO2AudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    if (data == nullptr || sizeInBytes < 6)
+        return;
+
+    juce::MemoryInputStream in(data, (size_t)sizeInBytes, false);
+
+    if (in.readInt() != stateMagic)
+        return;
+
+    const juce::ScopeGuard countLoad{ [this] { stateLoads.fetch_add(1); } }; // however far we get
+
+    const int version = in.readShort();
+    if (version < 1 || in.getNumBytesRemaining() < 19)
+        return;
+
+    // version 1
+    float newVolume = in.readFloat();
+    float newMix = in.readFloat();
+    float newDivision = in.readFloat();
+    float newHz = in.readFloat();
+    int newMode = in.readByte();
+    int newShape = in.readByte();
+    bool customActive = in.readBool();
+
+    Curve newCurve;
+    bool curveOk = newCurve.readFrom(in);
+
+    globalVolume = std::isfinite(newVolume) ? std::max(0.0f, newVolume) : 1.0f;
+    mix = std::isfinite(newMix) ? juce::jlimit(0.0f, 1.0f, newMix) : 1.0f;
+    // rate state belongs to the audio thread, so it goes over as one command
+    requestRateState((newMode >= (int)RateMode::BPM && newMode <= (int)RateMode::BPM_HZ) ? (RateMode)newMode : RateMode::BPM,
+                     std::isfinite(newDivision) && newDivision > 0.0f ? newDivision : 1.0f,
+                     std::isfinite(newHz) && newHz > 0.0f ? newHz : 1.0f);
+
+    if (newShape >= (int)LFO::Shape::Saw && newShape <= (int)LFO::Shape::RandomSmooth)
+        lfo.setShape((LFO::Shape)newShape);
+
+    // a curve that doesn't parse leaves the stream at an unknown offset, so nothing after
+    // it can be trusted: keep the defaults for the rest rather than read garbage
+    if (!curveOk)
+    {
+        lfo.clearCustomWaveform();
+        lfo.clearMorphWaveform();
+        return;
+    }
+
+    setCurve(newCurve);
+
+    // the 1024-sample table is rebuilt off the message thread
+    if (customActive)
+        bakeCurveInBackground(newCurve, false);
+    else
+        lfo.clearCustomWaveform();
+
+    // version 2: A/B morph
+    bool morphActive = false;
+    Curve newCurveB;
+    if (version >= 2 && in.getNumBytesRemaining() >= 5)
+    {
+        float newMorph = in.readFloat();
+        morphActive = in.readBool();
+
+        if (std::isfinite(newMorph))
+            *morphParam = juce::jlimit(0.0f, 1.0f, newMorph);
+
+        if (!newCurveB.readFrom(in))
+        {
+            lfo.clearMorphWaveform(); // same as curve A: the rest would be misaligned
+            return;
+        }
+        setCurveB(newCurveB);
+    }
+
+    if (morphActive)
+        bakeCurveInBackground(newCurveB, true);
+    else
+        lfo.clearMorphWaveform();
+
+    // version 3: snap glide
+    if (version >= 3 && in.getNumBytesRemaining() >= 5)
+    {
+        float newGlide = in.readFloat();
+        snapGlideInBeats = in.readBool();
+        if (std::isfinite(newGlide))
+            snapGlide = juce::jlimit(0.0f, snapGlideInBeats.load() ? 16.0f : 10000.0f, newGlide);
+    }
+
+    // version 4: multiband
+    if (version >= 4 && in.getNumBytesRemaining() >= 1 + 4 * (Multiband::maxBands - 1) + 9 * Multiband::maxBands)
+    {
+        multiband.numBands = juce::jlimit(1, Multiband::maxBands, (int)in.readByte());
+        for (auto& hz : multiband.crossoverHz)
+        {
+            const float newHz = in.readFloat();
+            if (std::isfinite(newHz))
+                hz = juce::jlimit(20.0f, 20000.0f, newHz);
+        }
+        for (auto& band : multiband.bands)
+        {
+            const float newDepth = in.readFloat();
+            const float newOffset = in.readFloat();
+            band.rateMultiple = juce::jlimit(1, 4, (int)in.readByte());
+            band.depth = std::isfinite(newDepth) ? juce::jlimit(0.0f, 1.0f, newDepth) : 1.0f;
+            band.phaseOffset = std::isfinite(newOffset) ? newOffset - std::floor(newOffset) : 0.0f;
+        }
+    }
+
+    // version 5: sidechain
+    if (version >= 5 && in.getNumBytesRemaining() >= 12)
+    {
+        const float newAmount = in.readFloat();
+        const float newAttack = in.readFloat();
+        const float newRelease = in.readFloat();
+        sidechain.amount = std::isfinite(newAmount) ? juce::jlimit(-1.0f, 1.0f, newAmount) : 0.0f;
+        if (std::isfinite(newAttack))
+            sidechain.attackMs = juce::jlimit(0.1f, 200.0f, newAttack);
+        if (std::isfinite(newRelease))
+            sidechain.releaseMs = juce::jlimit(5.0f, 2000.0f, newRelease);
+    }
+
+    // version 6: transient retrigger
+    if (version >= 6 && in.getNumBytesRemaining() >= 9)
+    {
+        const int newSource = in.readByte();
+        const float newSensitivity = in.readFloat();
+        const float newRefractory = in.readFloat();
+        onsets.source = juce::jlimit((int)OnsetDetector::Source::Off, (int)OnsetDetector::Source::Sidechain, newSource);
+        if (std::isfinite(newSensitivity))
+            onsets.sensitivity = juce::jlimit(0.0f, 1.0f, newSensitivity);
+        if (std::isfinite(newRefractory))
+            onsets.refractoryMs = juce::jlimit(10.0f, 1000.0f, newRefractory);
+    }
+
+    // version 7: lookahead (changes the latency, so it goes through the setter)
+    if (version >= 7 && in.getNumBytesRemaining() >= 1)
+        setLookahead(in.readBool());
+
+    // version 8: stutter
+    if (version >= 8 && in.getNumBytesRemaining() >= 4)
+    {
+        const int newMode = in.readByte();
+        const int newDenominator = in.readByte();
+        const int newRepeats = in.readByte();
+        stutter.mode = juce::jlimit((int)Stutter::Mode::Off, (int)Stutter::Mode::Envelope, newMode);
+        if (juce::isPowerOfTwo(newDenominator) && newDenominator <= 16)
+            stutter.sliceDenominator = newDenominator;
+        stutter.repeats = juce::jlimit(2, 16, newRepeats);
+        stutter.reverse = in.readBool();
+    }
+
+    // version 9: mid/side
+    if (version >= 9 && in.getNumBytesRemaining() >= 13)
+    {
+        midSide.enabled = in.readBool();
+        const float newMid = in.readFloat();
+        const float newSide = in.readFloat();
+        const float newPhase = in.readFloat();
+        if (std::isfinite(newMid))
+            midSide.midDepth = juce::jlimit(0.0f, 1.0f, newMid);
+        if (std::isfinite(newSide))
+            midSide.sideDepth = juce::jlimit(0.0f, 1.0f, newSide);
+        if (std::isfinite(newPhase))
+            midSide.sidePhase = newPhase - std::floor(newPhase);
+    }
+
+    // version 10: step gate
+    if (version >= 10 && in.getNumBytesRemaining() >= 2 + StepGate::maxSteps * 9)
+    {
+        stepGate.enabled = in.readBool();
+        StepGate::Pattern pattern;
+        pattern.numSteps = in.readByte(); // setPattern snaps it to 16 or 32
+        for (auto& step : pattern.steps)
+        {
+            const float newLevel = in.readFloat();
+            const float newLength = in.readFloat();
+            step.level = std::isfinite(newLevel) ? juce::jlimit(0.0f, 1.0f, newLevel) : 1.0f;
+            step.length = std::isfinite(newLength) ? juce::jlimit(0.0f, 1.0f, newLength) : 0.5f;
+            step.tie = in.readBool();
+        }
+        stepGate.setPattern(pattern);
+    }
+
+    // version 11: shape sequencer
+    if (version >= 11 && in.getNumBytesRemaining() >= 2 + ShapeSequencer::maxSlots * 5)
+    {
+        setShapeSequencerEnabled(in.readBool());
+        ShapeSequencer::Sequence sequence;
+        sequence.numSlots = in.readByte();
+        for (auto& slot : sequence.slots)
+        {
+            slot.shape = (ShapeSequencer::Shape)in.readByte();
+            slot.cyclesPerBar = in.readFloat();
+        }
+        shapeSequencer.setSequence(sequence); // clamps whatever came in
+    }
+
+    // version 12: random shapes
+    if (version >= 12 && in.getNumBytesRemaining() >= 8)
+    {
+        const float newHumanize = in.readFloat();
+        humanize = std::isfinite(newHumanize) ? juce::jlimit(0.0f, 1.0f, newHumanize) : 0.0f;
+        randomSeed = juce::jlimit(0, 999, in.readInt());
+    }
+}
+
+Curve LFO2AudioProcessor::getCurve() const
+{
+    const juce::ScopedLock lock(curveLock);
+    return curve;
+}
+
+void LFO2AudioProcessor::setCurve(const Curve& newCurve)
+{
+    {
+        const juce::ScopedLock lock(curveLock);
+        curve = newCurve;
+    }
+
+    // sequencer slots that play the drawn curve, baked off the message thread
+    if (shapeSequencer.enabled.load())
+        curveBaker->submit(shapeSequencer, newCurve);
+}
+
+void LFO2AudioProcessor::setShapeSequencerEnabled(bool shouldBeEnabled)
+{
+    const bool wasEnabled = shapeSequencer.enabled.exchange(shouldBeEnabled);
+    if (shouldBeEnabled && !wasEnabled)
+        curveBaker->submit(shapeSequencer, getCurve()); // it skipped every edit while it was off
+}
+
+void LFO2AudioProcessor::loadPreset(int index)
+{
+    PresetBank::Settings settings;
+    Curve presetCurve;
+    if (!presetBank->getSettings(index, settings) || !presetBank->getCurve(index, presetCurve))
+        return;
+
+    // the table was baked when the preset was saved, so this is just a copy into the
+    // LFO's spare slot and the same lock-free publish that curve edits use
+    presetBank->withTable(index, [this](const float* table, int size) { lfo.setCustomWaveform(table, size); });
+    setCurve(presetCurve);
+
+    mix = std::isfinite(settings.mix) ? juce::jlimit(0.0f, 1.0f, settings.mix) : mix;
+
+    requestRateState((settings.mode >= (int)RateMode::BPM && settings.mode <= (int)RateMode::BPM_HZ) ? (RateMode)settings.mode : currentMode.load(),
+                     std::isfinite(settings.division) && settings.division > 0.0f ? settings.division : division.load(),
+                     std::isfinite(settings.hz) && settings.hz > 0.0f ? settings.hz : currentHz.load());
+    if (settings.shape >= (int)LFO::Shape::Saw && settings.shape <= (int)LFO::Shape::RandomSmooth)
+        lfo.setShape((LFO::Shape)settings.shape);
+}
+
+bool LFO2AudioProcessor::savePreset(const juce::String& name)
+{
+    PresetBank::Settings settings;
+    settings.division = division.load();
+    settings.hz = currentHz.load();
+    settings.mix = mix;
+    settings.mode = (int)currentMode.load();
+    settings.shape = (int)lfo.getShape();
+
+    return presetBank->add(name, getCurve(), settings);
+}
+
+//==============================================================================
+void LFO2AudioProcessor::requestRateMode(RateMode mode)
+{
+    RateCommand command;
+    command.type = RateCommand::Type::SetMode;
+    command.mode = mode;
+    postRateCommand(command);
+}
+
+void LFO2AudioProcessor::requestDivision(float newDivision)
+{
+    RateCommand command;
+    command.type = RateCommand::Type::SetDivision;
+    command.division = newDivision;
+    postRateCommand(command);
+}
+
+void LFO2AudioProcessor::requestHz(float hz)
+{
+    RateCommand command;
+    command.type = RateCommand::Type::SetHz;
+    command.hz = hz;
+    postRateCommand(command);
+}
+
+void LFO2AudioProcessor::requestRateState(RateMode mode, float newDivision, float hz)
+{
+    auto isValid = [](float v) { return std::isfinite(v) && v > 0.0f; };
+
+    RateCommand restore;
+    restore.type = RateCommand::Type::Restore;
+    restore.mode = mode;
+    restore.division = isValid(newDivision) ? newDivision : 1.0f;
+    restore.hz = isValid(hz) ? hz : 1.0f;
+    {
+        const juce::SpinLock::ScopedLockType lock(pendingRestoreLock);
+        pendingRestore = { restore.mode, restore.division, restore.hz };
+        restore.sequence = ++restoresPosted;
+    }
+    postRateCommand(restore);
+}
+
+float LFO2AudioProcessor::nearestBpmDivision(float newDivision)
+{
+    if (!std::isfinite(newDivision) || newDivision <= 0.0f)
+        return 1.0f;
+
+    // nearest by ratio, so 3 lands on 4 rather than 1
+    float best = bpmDivisions.front();
+    for (const float d : bpmDivisions)
+        if (std::abs(std::log(newDivision / d)) < std::abs(std::log(newDivision / best)))
+            best = d;
+    return best;
+}
+
+LFO2AudioProcessor::RateState LFO2AudioProcessor::getRateStateForDisplay() const
+{
+    {
+        const juce::SpinLock::ScopedLockType lock(pendingRestoreLock);
+        if (restoresApplied.load() != restoresPosted)
+            return pendingRestore;
+    }
+    return { currentMode.load(), division.load(), currentHz.load() };
+}
+
+void LFO2AudioProcessor::requestSnap(float gridDivision)
+{
+    RateCommand command;
+    command.type = RateCommand::Type::Snap;
+    command.division = gridDivision;
+    postRateCommand(command);
+}
+
+void LFO2AudioProcessor::postRateCommand(const RateCommand& command)
+{
+    // only fills up if the host stops calling processBlock without releasing us
+    if (!rateCommands.push(command))
+    {
+        jassertfalse;
+        droppedCommands.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void LFO2AudioProcessor::applyRateCommands()
+{
+    if (auto dropped = droppedCommands.exchange(0, std::memory_order_relaxed))
+        eventLog.push(EventLog::Type::CommandsDropped, 0, (float)dropped);
+
+    const auto modeBefore = currentMode.load();
+
+    rateCommands.drain([this](const RateCommand& command)
+    {
+        auto isValid = [](float v) { return std::isfinite(v) && v > 0.0f; };
+
+        switch (command.type)
+        {
+        case RateCommand::Type::SetMode:
+        {
+            // convert from whatever is audible right now so the switch doesn't change speed
+            const float beatsPerSecond = bpm.load() / 60.0f;
+            const float playingHz = isValid(lfo.getRateHz()) ? lfo.getRateHz() : currentHz.load();
+
+            if (command.mode == RateMode::BPM)
+                division = nearestBpmDivision(beatsPerSecond / playingHz); // BPM only has the slider's steps
+            else
+                currentHz = playingHz;
+
+            currentMode = command.mode;
+
+            // BPM follows the grid, so it glides onto it; the free modes just keep going
+            gridLocked = command.mode == RateMode::BPM;
+            if (gridLocked)
+                startSnapGlide();
+            break;
+        }
+
+        case RateCommand::Type::SetDivision:
+            if (isValid(command.division))
+            {
+                division = command.division;
+                startSnapGlide(); // a new division moves where the grid says we should be
+            }
+            break;
+
+        case RateCommand::Type::SetHz:
+            if (isValid(command.hz))
+            {
+                currentHz = command.hz;
+                if (currentMode.load() == RateMode::BPM_HZ)
+                    gridLocked = false; // left the snap point, free running again
+            }
+            break;
+
+        case RateCommand::Type::Snap:
+            if (isValid(command.division) && currentMode.load() == RateMode::BPM_HZ)
+            {
+                // the slider reports every drag step, only a new snap point starts a glide
+                if (!gridLocked || division.load() != command.division)
+                    startSnapGlide();
+
+                division = command.division;
+                gridLocked = true;
+            }
+            break;
+
+        case RateCommand::Type::Restore:
+            currentMode = command.mode;
+            division = isValid(command.division) ? command.division : 1.0f;
+            currentHz = isValid(command.hz) ? command.hz : 1.0f;
+            gridLocked = command.mode == RateMode::BPM;
+            startSnapGlide();
+            restoresApplied = command.sequence;
+            break;
+        }
+    });
+
+    if (currentMode.load() != modeBefore)
+        eventLog.push(EventLog::Type::ModeChange, 0, (float)modeBefore, (float)currentMode.load());
+}
+
+//==============================================================================
+void LFO2AudioProcessor::startSnapGlide()
+{
+    const double sr = getSampleRate() > 0.0 ? getSampleRate() : 44100.0;
+    const float amount = juce::jmax(0.0f, snapGlide.load());
+
+    const double seconds = snapGlideInBeats.load() ? amount * 60.0 / juce::jmax(1.0f, bpm.load())
+                                                   : amount * 0.001;
+    glideSamplesLeft = (juce::int64)(seconds * sr);
+}
+
+void LFO2AudioProcessor::updateGridSync(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position,
+                                        int numSamples, float hostBpm, float gridDivision)
+{
+    lfo.setPhaseCorrection(0.0, 0.0);
+
+    const bool playing = position && position->getIsPlaying() && position->getPpqPosition();
+    if (!playing || numSamples <= 0)
+    {
+        if (wasPlaying)
+            eventLog.push(EventLog::Type::TransportStop);
+
+        // no grid to follow: free running at the rate that's set, like before
+        wasPlaying = false;
+        phaseError = 0.0f;
+
+        if (randomSeed.load() != lastRandomSeed)
+        {
+            lastRandomSeed = randomSeed.load();
+            lfo.seedRandom(Xoshiro::combine((std::uint64_t)lastRandomSeed, 0));
+        }
+        return;
+    }
+
+    const double ppq = *position->getPpqPosition();
+    const double beatsPerSample = hostBpm / (60.0 * getSampleRate());
+
+    // division is beats per LFO cycle, so the grid's phase is just the wrapped ppq
+    const double gridPhase = ppq / gridDivision - std::floor(ppq / gridDivision);
+
+    double error = lfo.getPhase() - gridPhase;
+    error -= std::floor(error + 0.5); // shortest way round, -0.5..0.5
+    phaseError = (float)error;
+
+    // with transient retrigger on, the hits set the phase and the grid only sets the rate
+    const bool locked = !retriggering
+                     && (currentMode.load() == RateMode::BPM
+                      || (currentMode.load() == RateMode::BPM_HZ && gridLocked));
+
+    // transport start or a jump (loop, locate): the grid moved, so follow it outright
+    const bool jumped = !wasPlaying || std::abs(ppq - expectedPpq) > 0.01;
+    if (!wasPlaying)
+        eventLog.push(EventLog::Type::TransportStart);
+    else if (jumped)
+        eventLog.push(EventLog::Type::PlayheadJump, 0, (float)expectedPpq, (float)ppq);
+
+    wasPlaying = true;
+    expectedPpq = ppq + numSamples * beatsPerSample;
+
+    // random values pick up from the seed and the grid cycle we're in, locked or not
+    if (jumped || randomSeed.load() != lastRandomSeed)
+    {
+        lastRandomSeed = randomSeed.load();
+        lfo.seedRandom(Xoshiro::combine((std::uint64_t)lastRandomSeed, (juce::int64)std::floor(ppq / gridDivision)));
+    }
+
+    if (!locked)
+        return;
+
+    if (jumped)
+    {
+        lfo.setPhase(gridPhase);
+        glideSamplesLeft = 0;
+        phaseError = 0.0f;
+        return;
+    }
+
+    // closed form, once per block: add an increment offset that falls linearly to zero
+    // at the end of the glide. Its sum over the remaining R samples is a*R/2, so a = -2e/R
+    // lands the phase exactly on the grid with no rate jump at the end. Re-solving it
+    // every block against the real error keeps it honest through tempo changes, and
+    // after the glide R is just this block, which holds the lock.
+    const double remaining = (double)juce::jmax<juce::int64>(glideSamplesLeft, numSamples);
+    const double offset = -2.0 * error / remaining;
+    lfo.setPhaseCorrection(offset, -offset / remaining);
+
+    glideSamplesLeft = juce::jmax<juce::int64>(0, glideSamplesLeft - numSamples);
+}
+
+Curve LFO2AudioProcessor::getCurveB() const
+{
+    const juce::ScopedLock lock(curveLock);
+    return curveB;
+}
+
+void LFO2AudioProcessor::setCurveB(const Curve& newCurve)
+{
+    const juce::ScopedLock lock(curveLock);
+    curveB = newCurve;
+}
+
+void LFO2AudioProcessor::curveEdited(const Curve& editedCurve, bool isCurveB)
+{
+    if (isCurveB)
+        setCurveB(editedCurve);
+    else
+        setCurve(editedCurve); // keep the saved curve in step
+
+    bakeCurveInBackground(editedCurve, isCurveB);
+}
+
+void LFO2AudioProcessor::bakeCurveInBackground(const Curve& curveToBake, bool toMorphTable)
+{
+    curveBaker->submit(lfo, toMorphTable, curveToBake, bakeResolution);
 }
 
 //==============================================================================
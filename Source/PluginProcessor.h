@@ -10,6 +10,22 @@
 
 #include <JuceHeader.h>
 #include "LFO.h"
+#include "Curve.h"
+#include "PresetBank.h"
+#include "CommandQueue.h"
+#include "CurveBaker.h"
+#include "DspLoadMeter.h"
+#include "EventLog.h"
+#include "OutputMonitor.h"
+#include "SpectrumTap.h"
+#include "Multiband.h"
+#include "Sidechain.h"
+#include "OnsetDetector.h"
+#include "Lookahead.h"
+#include "Stutter.h"
+#include "MidSide.h"
+#include "StepGate.h"
+#include "ShapeSequencer.h"
 #include "WaveFormEditor.h"
 
 //==============================================================================
@@ -60,33 +76,170 @@ public:
     float globalVolume = 100.0f;
 
     //bpm and LFO 
-    float bpm = 122.0f; //hardcoded 
+    std::atomic<float> bpm{ 122.0f }; // from the host, written on the audio thread
     //getPlayHead()->getPosition()->getBpm(); //hardcoded values 
-    float division = 16; //default 1/16th 
     float mix = 1.0f; // 1.0 full effect 0 is dry 
     //double sampleRate = sampleRate;
 
     LFO lfo;
+    Multiband multiband; // band split + per-band gating, off (one band) by default
+    SidechainFollower sidechain; // sidechain envelope -> LFO depth, off until amount is set
+    OnsetDetector onsets;        // transients in the input or sidechain restart the LFO, off by default
 
-    enum class RateMode { BPM, HZ, BPM_HZ };
-    RateMode currentMode = RateMode::BPM;
+    Lookahead lookahead;         // delays the audio so the gain lands early and snaps to zero crossings
+    Stutter stutter;             // grid-synced slice repeat, off by default
+    MidSide midSide;             // separate mid/side depths on a stereo bus, off by default
+    StepGate stepGate;           // per-bar step pattern instead of the LFO curve, off by default
+    ShapeSequencer shapeSequencer; // a different shape per bar instead of the LFO curve, off by default
+
+    bool isSidechainConnected() const; // message thread
 
-    float currentHz = 1.0f;
+    // message thread: turns the lookahead on/off and reports the latency it adds to the host
+    void setLookahead(bool shouldBeOn);
 
+    DspLoadMeter loadMeter; // processBlock time vs. its real-time budget, for the editor's HUD
+    EventLog eventLog;      // audio-thread diagnostics, written to EventLogWriter::getLogFile()
+    OutputMonitor outputMonitor; // output levels and the applied gain, for the editor's meters/scope
+    SpectrumTap spectrumTap; // input/output samples for the spectrum view, only while it's open
+
+    enum class RateMode { BPM, HZ, BPM_HZ };
 
-    float getLFORateHz() const { return (lfo.getRateHz()*2); }
+    // rate state is owned by the audio thread: anything else reads these, and changes
+    // them by posting a RateCommand that gets applied at the next block boundary
+    std::atomic<RateMode> currentMode{ RateMode::BPM };
+    std::atomic<float> division{ 16.0f }; //default 1/16th 
+    std::atomic<float> currentHz{ 1.0f };
+
+    struct RateCommand
+    {
+        enum class Type { SetMode, SetDivision, SetHz, Snap, Restore };
+
+        Type type = Type::SetMode;
+        RateMode mode = RateMode::BPM;
+        float division = 1.0f;
+        float hz = 1.0f;
+        juce::uint32 sequence = 0; // Restore only: which requestRateState call this was
+    };
+
+    struct RateState
+    {
+        RateMode mode = RateMode::BPM;
+        float division = 1.0f;
+        float hz = 1.0f;
+    };
+
+    // message thread: what the rate controls should show. A restore (preset or session
+    // load) the audio thread hasn't applied yet wins over the state it's about to replace,
+    // so a stopped transport doesn't leave the old preset's rate on screen
+    RateState getRateStateForDisplay() const;
+
+    // the divisions the BPM rate slider has steps for; switching to BPM lands on the nearest
+    static constexpr std::array<float, 5> bpmDivisions{ 16.0f, 4.0f, 1.0f, 0.5f, 0.25f };
+    static float nearestBpmDivision(float division);
+
+    // bumped by every setStateInformation call, so an open editor knows to resync
+    std::atomic<juce::uint32> stateLoads{ 0 };
+
+    // message thread: switching mode converts from the rate that's actually playing
+    void requestRateMode(RateMode mode);
+    void requestDivision(float newDivision);
+    void requestHz(float hz);
+    void requestRateState(RateMode mode, float newDivision, float hz); // all three at once, no conversion
+    void requestSnap(float gridDivision); // BPM/Hz: slider landed on a division, glide onto the grid
+
+    // how long a snap takes to pull phase and rate back onto the host grid
+    std::atomic<float> snapGlide{ 250.0f };
+    std::atomic<bool> snapGlideInBeats{ false }; // false: snapGlide is in ms
+
+    // LFO phase minus where the host grid says it should be, in cycles (-0.5..0.5)
+    std::atomic<float> phaseError{ 0.0f };
+
+    // random shapes: per-cycle level/timing jitter (0..1), and the seed their values come
+    // from. The audio thread reseeds from it and the host position on every transport
+    // start or jump, so a render from the same spot always plays the same values
+    std::atomic<float> humanize{ 0.0f };
+    std::atomic<int> randomSeed{ 1 };
+
+
+    // the rate the LFO is actually playing, published by the audio thread once per block.
+    // Read this from the GUI, never lfo.getRateHz() (that one belongs to the audio thread)
+    float getLFORateHz() const { return playingHz.load(std::memory_order_relaxed); }
+
+    // drawn curve, kept here so it survives save/load (never touched on the audio thread)
+    Curve getCurve() const;
+    void setCurve(const Curve& newCurve);
+
+    // "B" curve the LFO morphs towards
+    Curve getCurveB() const;
+    void setCurveB(const Curve& newCurve);
+
+    // GUI edit: stores the curve and hands it to the baker, returns straight away
+    void curveEdited(const Curve& editedCurve, bool isCurveB);
+
+    // turns the shape sequencer on or off; turning it on bakes the drawn curve for it once
+    // (while it's off, curve edits don't bake a table for it at all)
+    void setShapeSequencerEnabled(bool shouldBeEnabled);
+
+    // automatable A/B morph position
+    juce::AudioParameterFloat* morphParam = nullptr;
+
+    // user preset library (message thread)
+    PresetBank& getPresetBank() { return *presetBank; }
+    void loadPreset(int index);
+    bool savePreset(const juce::String& name);
 
 private:
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LFO2AudioProcessor)
 
+    // state chunk header, bump the version whenever fields are appended
+    static constexpr int stateMagic = 0x4e524843; // "CHRN"
+    static constexpr int stateVersion = 12;
+
+    juce::CriticalSection curveLock;
+    Curve curve;
+    Curve curveB;
+
+    std::vector<float> gainBuffer; // per-block LFO gain, sized in prepareToPlay
+
+    CommandQueue<RateCommand, 64> rateCommands;
+    std::atomic<juce::uint32> droppedCommands{ 0 }; // pushes the full queue refused, logged by the audio thread
+    void postRateCommand(const RateCommand& command);
+
+    // the newest requestRateState values, until the audio thread has caught up with them
+    mutable juce::SpinLock pendingRestoreLock;
+    RateState pendingRestore;
+    juce::uint32 restoresPosted = 0;                // under pendingRestoreLock
+    std::atomic<juce::uint32> restoresApplied{ 0 }; // written by whoever applies the commands
+    void applyRateCommands(); // audio thread (or while it's stopped)
+
+    // grid snap-back, audio thread only
+    bool gridLocked = true;           // following host PPQ: always in BPM, after a snap in BPM/Hz
+    juce::int64 glideSamplesLeft = 0; // samples left to close the phase error in
+    bool wasPlaying = false;
+    double expectedPpq = 0.0;         // where the playhead should be next block, to spot jumps/loops
+    bool retriggering = false;        // onsets own the phase this block, so don't lock it to the grid
+    int lastRandomSeed = -1;          // the randomSeed the LFO was last seeded with
+    std::atomic<float> playingHz{ 1.0f }; // LFO rate as of the last block, see getLFORateHz
+
+    void startSnapGlide();
+    void updateGridSync(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position,
+                        int numSamples, float hostBpm, float gridDivision);
+
+    // one bake thread shared by every instance, so big sessions don't spawn a thread each
+    juce::SharedResourcePointer<CurveBaker> curveBaker;
+    static constexpr int bakeResolution = 1024;
+
+    void bakeCurveInBackground(const Curve& curveToBake, bool toMorphTable);
+
+    juce::SharedResourcePointer<PresetBank> presetBank; // one mapped bank for every instance
+
+    juce::SharedResourcePointer<EventLogWriter> eventLogWriter; // drains every instance's log to disk
+    juce::uint32 loggedCustomSwaps = 0, loggedMorphSwaps = 0;   // audio thread
+
     float volume = 1.0f; // example for your volume slider test
     //float lfoRateHz = 1.0f; //current LFO rate in Hz
 
-
-    juce::AudioFormatManager formatManager; //wav file testing
-    std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
-    juce::AudioTransportSource transportSource;
-    bool usingTestAudio = false;
+    // file playback for testing lives in the offline renderer (Tools/), not in the plugin
 
 };
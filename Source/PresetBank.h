@@ -0,0 +1,266 @@
+// PresetBank.h
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <cstring>
+#include "Curve.h"
+
+// User preset library kept in one indexed bank file that gets memory-mapped, so browsing
+// thousands of presets never parses files one by one. Each record carries the table that
+// was baked when the preset was saved, so loading one is a copy, not a bake.
+//
+// layout (little-endian, everything 4-byte aligned so tables can be read in place):
+//   header   32 bytes    magic "CHPB", version, count, table size, reserved
+//   index    64 bytes    per preset: utf-8 name (48 bytes, zero padded), record offset (int64), record size, reserved
+//   records              settings (16 bytes), baked table (tableSize floats), curve (Curve::writeTo), padding
+class PresetBank
+{
+public:
+    struct Settings
+    {
+        float division = 1.0f;
+        float hz = 1.0f;
+        float mix = 1.0f;
+        int mode = 0;  // LFO2AudioProcessor::RateMode
+        int shape = 0; // LFO::Shape
+    };
+
+    static constexpr int tableSize = 1024;
+
+    explicit PresetBank(const juce::File& bankFile = getDefaultFile()) : file(bankFile)
+    {
+        reload();
+    }
+
+    static juce::File getDefaultFile()
+    {
+        return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+            .getChildFile("Chronos")
+            .getChildFile("Presets.chpb");
+    }
+
+    // (re)maps the bank and checks the header and index; an unusable file just means an empty bank
+    bool reload()
+    {
+        const juce::ScopedWriteLock lock(mapLock);
+        return remap();
+    }
+
+    int size() const
+    {
+        const juce::ScopedReadLock lock(mapLock);
+        return numPresets;
+    }
+
+    juce::String getName(int index) const
+    {
+        const juce::ScopedReadLock lock(mapLock);
+        if (!isPositiveAndBelow(index)) return {};
+
+        auto* entry = indexEntry(index);
+        return juce::String::fromUTF8(entry, (int)strnlen(entry, nameBytes));
+    }
+
+    bool getSettings(int index, Settings& result) const
+    {
+        const juce::ScopedReadLock lock(mapLock);
+        if (!isPositiveAndBelow(index)) return false;
+
+        auto* rec = record(index);
+        result.division = readFloat(rec);
+        result.hz = readFloat(rec + 4);
+        result.mix = readFloat(rec + 8);
+        result.mode = (juce::uint8)rec[12];
+        result.shape = (juce::uint8)rec[13];
+        return true;
+    }
+
+    bool getCurve(int index, Curve& result) const
+    {
+        const juce::ScopedReadLock lock(mapLock);
+        if (!isPositiveAndBelow(index)) return false;
+
+        const int curveOffset = settingsBytes + tableSize * 4;
+        juce::MemoryInputStream in(record(index) + curveOffset, (size_t)(recordSize(index) - curveOffset), false);
+        return result.readFrom(in);
+    }
+
+    // calls fn(const float* table, int size) with the baked table, read straight out of the map
+    template <typename Fn>
+    bool withTable(int index, Fn&& fn) const
+    {
+        const juce::ScopedReadLock lock(mapLock);
+        if (!isPositiveAndBelow(index)) return false;
+
+        fn(reinterpret_cast<const float*>(record(index) + settingsBytes), tableSize);
+        return true;
+    }
+
+    // appends a preset: existing records are copied over raw, the new one is baked once here,
+    // and the whole bank is swapped in through a temp file
+    bool add(const juce::String& name, const Curve& curve, const Settings& settings)
+    {
+        juce::MemoryOutputStream newRecord;
+        writeRecord(newRecord, curve, settings);
+
+        juce::MemoryOutputStream index, records;
+        juce::int64 recordStart = 0;
+        int count = 0;
+
+        auto addEntry = [&](const juce::String& entryName, const void* data, size_t bytes)
+        {
+            writeIndexEntry(index, entryName, recordStart + (juce::int64)records.getDataSize(), (int)bytes);
+            records.write(data, bytes);
+            ++count;
+        };
+
+        {
+            const juce::ScopedReadLock lock(mapLock);
+            recordStart = headerSize + (juce::int64)(numPresets + 1) * indexEntrySize;
+
+            for (int i = 0; i < numPresets; ++i)
+            {
+                auto* entry = indexEntry(i);
+                addEntry(juce::String::fromUTF8(entry, (int)strnlen(entry, nameBytes)), record(i), (size_t)recordSize(i));
+            }
+        }
+        addEntry(name, newRecord.getData(), newRecord.getDataSize());
+
+        if (!file.getParentDirectory().createDirectory())
+            return false;
+
+        juce::TemporaryFile temp(file);
+        {
+            juce::FileOutputStream out(temp.getFile());
+            if (!out.openedOk())
+                return false;
+
+            out.writeInt(magic);
+            out.writeInt(version);
+            out.writeInt(count);
+            out.writeInt(tableSize);
+            out.writeInt64(0); // reserved
+            out.writeInt64(0);
+            out << index << records;
+            out.flush();
+
+            if (out.getStatus().failed())
+                return false;
+        }
+
+        // the old map has to go before the file can be replaced (Windows won't swap a mapped file)
+        const juce::ScopedWriteLock lock(mapLock);
+        map.reset();
+        numPresets = 0;
+        bool replaced = temp.overwriteTargetFileWithTemporary();
+        remap();
+        return replaced;
+    }
+
+private:
+    static constexpr int magic = 0x42504843; // "CHPB"
+    static constexpr int version = 1;
+    static constexpr int headerSize = 32;
+    static constexpr int indexEntrySize = 64;
+    static constexpr int nameBytes = 48;
+    static constexpr int settingsBytes = 16;
+    static constexpr int minRecordSize = settingsBytes + tableSize * 4;
+
+    juce::File file;
+    juce::ReadWriteLock mapLock;
+    std::unique_ptr<juce::MemoryMappedFile> map;
+    int numPresets = 0;
+
+    bool remap()
+    {
+        map.reset();
+        numPresets = 0;
+
+        // tables are read in place, so the file's byte order has to match ours
+        if (juce::ByteOrder::isBigEndian() || !file.existsAsFile())
+            return false;
+
+        auto mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+        auto* base = static_cast<const char*>(mapped->getData());
+        auto bytes = (juce::int64)mapped->getSize();
+
+        if (base == nullptr || bytes < headerSize)
+            return false;
+
+        if (readInt(base) != magic || readInt(base + 4) != version || readInt(base + 12) != tableSize)
+            return false;
+
+        int count = readInt(base + 8);
+        if (count < 0 || headerSize + (juce::int64)count * indexEntrySize > bytes)
+            return false;
+
+        // every record must sit inside the file before anyone reads through the map
+        for (int i = 0; i < count; ++i)
+        {
+            auto* entry = base + headerSize + i * indexEntrySize;
+            auto offset = (juce::int64)juce::ByteOrder::littleEndianInt64(entry + nameBytes);
+            auto length = readInt(entry + nameBytes + 8);
+
+            if (offset < 0 || (offset % 4) != 0 || length < minRecordSize || offset + length > bytes)
+                return false;
+        }
+
+        map = std::move(mapped);
+        numPresets = count;
+        return true;
+    }
+
+    bool isPositiveAndBelow(int index) const { return juce::isPositiveAndBelow(index, numPresets); }
+
+    const char* base() const { return static_cast<const char*>(map->getData()); }
+    const char* indexEntry(int index) const { return base() + headerSize + index * indexEntrySize; }
+    const char* record(int index) const { return base() + juce::ByteOrder::littleEndianInt64(indexEntry(index) + nameBytes); }
+    int recordSize(int index) const { return readInt(indexEntry(index) + nameBytes + 8); }
+
+    static int readInt(const char* p) { return (int)juce::ByteOrder::littleEndianInt(p); }
+
+    static float readFloat(const char* p)
+    {
+        float f;
+        std::memcpy(&f, p, sizeof(f));
+        return f;
+    }
+
+    static void writeIndexEntry(juce::OutputStream& out, juce::String name, juce::int64 offset, int length)
+    {
+        // trim whole characters until the utf-8 form fits (keeps room for the terminator)
+        while (name.getNumBytesAsUTF8() >= (size_t)nameBytes)
+            name = name.dropLastCharacters(1);
+
+        char padded[nameBytes] = {};
+        name.copyToUTF8(padded, (size_t)nameBytes);
+        out.write(padded, (size_t)nameBytes);
+
+        out.writeInt64(offset);
+        out.writeInt(length);
+        out.writeInt(0); // reserved
+    }
+
+    static void writeRecord(juce::OutputStream& out, const Curve& curve, const Settings& settings)
+    {
+        out.writeFloat(settings.division);
+        out.writeFloat(settings.hz);
+        out.writeFloat(settings.mix);
+        out.writeByte((char)settings.mode);
+        out.writeByte((char)settings.shape);
+        out.writeShort(0); // pad to 16 bytes
+
+        float table[tableSize];
+        curve.bake(table, tableSize, true);
+        for (float v : table)
+            out.writeFloat(v);
+
+        curve.writeTo(out);
+
+        // keep the next record's table 4-byte aligned
+        while ((out.getPosition() % 4) != 0)
+            out.writeByte(0);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(PresetBank)
+};
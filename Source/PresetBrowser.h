@@ -0,0 +1,220 @@
+// PresetBrowser.h
+#pragma once
+#include <JuceHeader.h>
+#include <map>
+#include <vector>
+#include "PresetBank.h"
+
+// Renders preset thumbnails from the bank's baked tables on a background thread.
+// get() never blocks: it hands back what's cached and queues anything missing.
+class PresetThumbnailCache : public juce::ChangeBroadcaster,
+                             private juce::Thread
+{
+public:
+    PresetThumbnailCache(PresetBank& bankToUse, int thumbWidth, int thumbHeight)
+        : juce::Thread("Preset thumbnails"), bank(bankToUse), width(thumbWidth), height(thumbHeight)
+    {
+        startThread(juce::Thread::Priority::low);
+    }
+
+    ~PresetThumbnailCache() override { stopThread(2000); }
+
+    juce::Image get(int index)
+    {
+        {
+            const juce::ScopedLock sl(lock);
+            if (auto it = cache.find(index); it != cache.end())
+                return it->second;
+
+            if (std::find(queue.begin(), queue.end(), index) == queue.end())
+                queue.push_back(index);
+        }
+
+        notify();
+        return {};
+    }
+
+    // drop everything, e.g. after the bank was rewritten. A render already in flight was
+    // taken from the old bank, so the worker throws it away when it sees the new generation
+    void clear()
+    {
+        const juce::ScopedLock sl(lock);
+        cache.clear();
+        queue.clear();
+        ++generation;
+    }
+
+private:
+    PresetBank& bank;
+    const int width, height;
+    static constexpr size_t maxCached = 512;
+
+    juce::CriticalSection lock;
+    std::map<int, juce::Image> cache;
+    std::vector<int> queue;
+    juce::uint32 generation = 0; // bumped by clear(), under lock
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            int index = -1;
+            juce::uint32 jobGeneration = 0;
+            {
+                const juce::ScopedLock sl(lock);
+                if (!queue.empty())
+                {
+                    index = queue.back(); // newest request first, that's what is on screen
+                    queue.pop_back();
+                    jobGeneration = generation;
+                }
+            }
+
+            if (index < 0)
+            {
+                wait(-1);
+                continue;
+            }
+
+            auto image = render(index);
+            {
+                const juce::ScopedLock sl(lock);
+                if (jobGeneration != generation)
+                    continue; // the bank changed while we drew it
+
+                cache[index] = image;
+
+                // keep memory bounded on huge banks: forget whatever is furthest away
+                while (cache.size() > maxCached)
+                {
+                    auto first = cache.begin();
+                    auto last = std::prev(cache.end());
+                    cache.erase((index - first->first) > (last->first - index) ? first : last);
+                }
+            }
+
+            sendChangeMessage();
+        }
+    }
+
+    juce::Image render(int index) const
+    {
+        juce::Image image(juce::Image::ARGB, width, height, true, juce::SoftwareImageType());
+        juce::Graphics g(image);
+
+        g.setColour(juce::Colour(44, 44, 49));
+        g.fillRoundedRectangle(image.getBounds().toFloat(), 3.0f);
+
+        bank.withTable(index, [&](const float* table, int size)
+            {
+                juce::Path p;
+                for (int x = 0; x < width; ++x)
+                {
+                    int i = juce::jlimit(0, size - 1, x * (size - 1) / juce::jmax(1, width - 1));
+                    float y = 2.0f + (1.0f - table[i]) * (float)(height - 4);
+                    if (x == 0) p.startNewSubPath(0.0f, y);
+                    else        p.lineTo((float)x, y);
+                }
+
+                g.setColour(juce::Colour(40, 246, 177));
+                g.strokePath(p, juce::PathStrokeType(1.5f));
+            });
+
+        return image;
+    }
+};
+
+//==============================================================================
+// List of bank presets with thumbnails, plus a name box to save the current curve/settings.
+class PresetBrowser : public juce::Component,
+                      private juce::ListBoxModel,
+                      private juce::ChangeListener
+{
+public:
+    std::function<void(int)> onPresetChosen;
+    std::function<void(const juce::String&)> onSave;
+
+    explicit PresetBrowser(PresetBank& bankToUse)
+        : bank(bankToUse), thumbnails(bankToUse, thumbWidth, thumbHeight)
+    {
+        list.setModel(this);
+        list.setRowHeight(thumbHeight + 6);
+        list.setColour(juce::ListBox::backgroundColourId, juce::Colour(48, 48, 54));
+        addAndMakeVisible(list);
+
+        nameBox.setTextToShowWhenEmpty("Preset name", juce::Colours::grey);
+        nameBox.setColour(juce::TextEditor::backgroundColourId, juce::Colour(44, 44, 49));
+        nameBox.setColour(juce::TextEditor::outlineColourId, juce::Colour(35, 247, 176));
+        addAndMakeVisible(nameBox);
+
+        saveButton.onClick = [this]()
+        {
+            auto name = nameBox.getText().trim();
+            if (name.isEmpty() || !onSave)
+                return;
+
+            onSave(name);
+            nameBox.clear();
+            refresh();
+        };
+        addAndMakeVisible(saveButton);
+
+        thumbnails.addChangeListener(this);
+    }
+
+    ~PresetBrowser() override
+    {
+        thumbnails.removeChangeListener(this);
+        list.setModel(nullptr);
+    }
+
+    void refresh()
+    {
+        thumbnails.clear();
+        list.updateContent();
+        list.repaint();
+    }
+
+    void resized() override
+    {
+        auto r = getLocalBounds();
+        auto bottom = r.removeFromBottom(24);
+        saveButton.setBounds(bottom.removeFromRight(60));
+        nameBox.setBounds(bottom.withTrimmedRight(4));
+        list.setBounds(r.withTrimmedBottom(4));
+    }
+
+private:
+    static constexpr int thumbWidth = 96;
+    static constexpr int thumbHeight = 28;
+
+    PresetBank& bank;
+    PresetThumbnailCache thumbnails;
+
+    juce::ListBox list;
+    juce::TextEditor nameBox;
+    juce::TextButton saveButton{ "Save" };
+
+    int getNumRows() override { return bank.size(); }
+
+    void paintListBoxItem(int row, juce::Graphics& g, int width, int height, bool rowIsSelected) override
+    {
+        if (rowIsSelected)
+            g.fillAll(juce::Colour(63, 63, 68));
+
+        auto thumb = thumbnails.get(row);
+        if (thumb.isValid())
+            g.drawImageAt(thumb, 4, (height - thumb.getHeight()) / 2);
+
+        g.setColour(juce::Colour(142, 230, 179));
+        g.drawText(bank.getName(row), thumbWidth + 10, 0, width - thumbWidth - 14, height, juce::Justification::centredLeft, true);
+    }
+
+    void listBoxItemClicked(int row, const juce::MouseEvent&) override
+    {
+        if (onPresetChosen)
+            onPresetChosen(row);
+    }
+
+    void changeListenerCallback(juce::ChangeBroadcaster*) override { list.repaint(); }
+};
@@ -0,0 +1,262 @@
+// ShapeSequencer.h
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include "TripleBuffer.h"
+#include "Trace.h"
+
+// A different curve per bar: up to 16 slots, each one a shape (the drawn curve or one of the
+// built-ins) at so many cycles per bar, played in turn and looped along the host timeline.
+// Slower than one cycle per bar carries on across bars counted from the start of the song,
+// so a half-time sine in a one-slot sequence really does take two bars.
+//
+// The built-in shapes are baked once, in the constructor, and never change. The drawn curve
+// comes in already baked (the processor sends it through the shared CurveBaker, and only
+// while the sequencer is on), and goes over to the audio thread with the slots in one
+// TripleBuffer publish. On the audio thread a slot change only changes which table is read,
+// with a 10 ms crossfade from the previous slot.
+class ShapeSequencer
+{
+public:
+    static constexpr int maxSlots = 16;
+    static constexpr int tableSize = 2048;
+
+    enum class Shape { Drawn, Sine, Triangle, Saw, Square, Open, numShapes };
+
+    struct Slot
+    {
+        Shape shape = Shape::Drawn;
+        float cyclesPerBar = 1.0f; // 0.25 .. 16
+    };
+
+    struct Sequence
+    {
+        int numSlots = 4;
+        std::array<Slot, maxSlots> slots{};
+    };
+
+    static constexpr std::array<float, 7> rates{ 0.25f, 0.5f, 1.0f, 2.0f, 4.0f, 8.0f, 16.0f };
+
+    std::atomic<bool> enabled{ false }; // GUI writes, audio thread reads once per block
+
+    ShapeSequencer()
+    {
+        for (int s = 1; s < (int)Shape::numShapes; ++s)
+        {
+            auto& table = builtinTables[(size_t)s];
+            for (int i = 0; i < tableSize; ++i)
+                table[(size_t)i] = shapeAt((Shape)s, (double)i / tableSize);
+            table[tableSize] = table[0];
+        }
+
+        for (int i = 0; i < tableSize; ++i)
+            drawnTable[(size_t)i] = (float)i / (float)tableSize; // the LFO's default saw until a curve comes in
+        drawnTable[tableSize] = drawnTable[0];
+
+        sequence.slots[1].shape = Shape::Square;
+        sequence.slots[2].shape = Shape::Sine;
+        sequence.slots[2].cyclesPerBar = 0.5f;
+        sequence.slots[3].shape = Shape::Square;
+        sequence.slots[3].cyclesPerBar = 4.0f;
+        publish();
+    }
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        fadeSamples = juce::jmax(1, (int)(sampleRate * 0.010));
+        freePosition = 0.0;
+    }
+
+    // message thread: a new sequence
+    void setSequence(const Sequence& newSequence)
+    {
+        const juce::SpinLock::ScopedLockType lock(writerLock); // only ever taken by writers
+        sequence = newSequence;
+        sequence.numSlots = juce::jlimit(1, maxSlots, sequence.numSlots);
+        for (auto& slot : sequence.slots)
+        {
+            slot.shape = (Shape)juce::jlimit(0, (int)Shape::numShapes - 1, (int)slot.shape);
+            slot.cyclesPerBar = std::isfinite(slot.cyclesPerBar) ? juce::jlimit(rates.front(), rates.back(), slot.cyclesPerBar) : 1.0f;
+        }
+        publish();
+    }
+
+    Sequence getSequence() const
+    {
+        const juce::SpinLock::ScopedLockType lock(writerLock);
+        return sequence;
+    }
+
+    // the bake thread: the drawn curve, baked to tableSize samples
+    void setDrawnTable(const float* samples, int numSamples)
+    {
+        jassert(numSamples == tableSize);
+        const juce::SpinLock::ScopedLockType lock(writerLock);
+        std::copy(samples, samples + juce::jmin(numSamples, tableSize), drawnTable.begin());
+        drawnTable[tableSize] = drawnTable[0];
+        publish();
+    }
+
+    // audio thread: where on the timeline this block starts. Returns false if it's off.
+    bool beginBlock(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position, int numSamples, float hostBpm)
+    {
+        banks.acquire();
+        if (!enabled.load(std::memory_order_relaxed))
+            return false;
+
+        double barBeats = 4.0;
+        if (position && position->getTimeSignature())
+        {
+            const auto sig = *position->getTimeSignature();
+            if (sig.numerator > 0 && sig.denominator > 0)
+                barBeats = 4.0 * sig.numerator / sig.denominator;
+        }
+
+        const double beatSamples = sampleRate * 60.0 / juce::jmax(1.0f, hostBpm);
+        barIncrement = 1.0 / (barBeats * beatSamples);
+
+        // the host's PPQ when it's playing, our own count when it isn't
+        double bars = freePosition * barIncrement;
+        if (position && position->getIsPlaying() && position->getPpqPosition())
+        {
+            bars = *position->getPpqPosition() / barBeats;
+            freePosition = bars / barIncrement;
+        }
+        freePosition += numSamples;
+
+        barIndex = (juce::int64)std::floor(bars);
+        barPos = bars - (double)barIndex;
+        return true;
+    }
+
+    // audio thread: the sequence's curve (0..1) for the next n samples
+    void render(float* dest, int n)
+    {
+        CHRONOS_TRACE_SCOPE("ShapeSequencer::render");
+        const auto& bank = banks.getReadBuffer();
+
+        for (int i = 0; i < n;)
+        {
+            // up to the end of this bar, all from one slot (and the one before it while fading)
+            const int len = juce::jlimit(1, n - i, (int)std::ceil((1.0 - barPos) / barIncrement));
+            const auto& slot = bank.slots[slotIndex(bank, barIndex)];
+            const auto& previous = bank.slots[slotIndex(bank, barIndex - 1)];
+            const float* table = tableFor(bank, slot.shape);
+
+            double phase = cyclePhase(slot, barIndex, barPos);
+            const double increment = slot.cyclesPerBar * barIncrement;
+            for (int k = 0; k < len; ++k)
+            {
+                dest[i + k] = readTable(table, phase);
+                phase += increment;
+                if (phase >= 1.0)
+                    phase -= 1.0;
+            }
+
+            // first 10 ms of a bar that changes slot: fade in from where the last slot would be
+            const int intoBar = (int)(barPos / barIncrement);
+            if (intoBar < fadeSamples && (previous.shape != slot.shape || previous.cyclesPerBar != slot.cyclesPerBar))
+            {
+                const float* from = tableFor(bank, previous.shape);
+                double p = cyclePhase(previous, barIndex, barPos);
+                const double inc = previous.cyclesPerBar * barIncrement;
+                const int fadeLen = juce::jmin(len, fadeSamples - intoBar);
+                for (int k = 0; k < fadeLen; ++k)
+                {
+                    const float t = (float)(intoBar + k) / (float)fadeSamples;
+                    const float old = readTable(from, p);
+                    dest[i + k] = old + t * (dest[i + k] - old);
+                    p += inc;
+                    if (p >= 1.0)
+                        p -= 1.0;
+                }
+            }
+
+            barPos += len * barIncrement;
+            if (barPos >= 1.0 - 1.0e-9)
+            {
+                barPos = juce::jmax(0.0, barPos - 1.0);
+                ++barIndex;
+            }
+            i += len;
+        }
+    }
+
+private:
+    using Table = std::array<float, tableSize + 1>; // +1: wraps for the lerp
+
+    struct Bank
+    {
+        Table drawn{};
+        std::array<Slot, maxSlots> slots{};
+        int numSlots = 1;
+    };
+
+    std::array<Table, (size_t)Shape::numShapes> builtinTables{}; // written once, before any reader (Drawn unused)
+
+    Sequence sequence; // message thread copy, for the editor and the saved state
+    Table drawnTable{};
+    mutable juce::SpinLock writerLock;
+    TripleBuffer<Bank> banks;
+
+    // audio thread
+    double sampleRate = 44100.0;
+    int fadeSamples = 441;
+    double barPos = 0.0, barIncrement = 0.0;
+    juce::int64 barIndex = 0;
+    double freePosition = 0.0;
+
+    // fills the spare bank (it's a different slot than last time) and hands it over
+    void publish()
+    {
+        auto& bank = banks.getWriteBuffer();
+        bank.drawn = drawnTable;
+        bank.slots = sequence.slots;
+        bank.numSlots = sequence.numSlots;
+        banks.publish();
+    }
+
+    const float* tableFor(const Bank& bank, Shape shape) const
+    {
+        return shape == Shape::Drawn ? bank.drawn.data() : builtinTables[(size_t)shape].data();
+    }
+
+    static float shapeAt(Shape shape, double p)
+    {
+        switch (shape)
+        {
+        case Shape::Sine:     return 0.5f + 0.5f * (float)std::sin(juce::MathConstants<double>::twoPi * p);
+        case Shape::Triangle: return 1.0f - (float)std::abs(2.0 * p - 1.0);
+        case Shape::Saw:      return (float)p;
+        case Shape::Square:   return p < 0.5 ? 1.0f : 0.0f;
+        default:              return 1.0f; // open: the slot lets everything through
+        }
+    }
+
+    static size_t slotIndex(const Bank& bank, juce::int64 bar)
+    {
+        const juce::int64 count = juce::jmax(1, bank.numSlots);
+        return (size_t)(((bar % count) + count) % count);
+    }
+
+    // cycles counted from bar 0, so slow slots pick up where the last bar left them
+    static double cyclePhase(const Slot& slot, juce::int64 bar, double pos)
+    {
+        const double cycles = ((double)bar + pos) * slot.cyclesPerBar;
+        return cycles - std::floor(cycles);
+    }
+
+    static float readTable(const float* table, double phase)
+    {
+        const double idx = phase * tableSize;
+        const int i0 = juce::jlimit(0, tableSize - 1, (int)idx);
+        const float frac = (float)(idx - i0);
+        return table[i0] + frac * (table[i0 + 1] - table[i0]);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(ShapeSequencer)
+};
@@ -0,0 +1,189 @@
+// ShapeSequencerPanel.h
+#pragma once
+#include <JuceHeader.h>
+#include <functional>
+#include "Curve.h"
+#include "ShapeSequencer.h"
+
+// On/off, slot count and the slots of the processor's ShapeSequencer. Each cell shows its
+// slot's shape at its rate (the drawn one via getDrawnCurveFn); click one for a menu of
+// shapes and rates. On/off goes through setEnabledFn, so the processor can bake the drawn
+// curve as it turns on. refresh() pulls the sequence back after a state load.
+class ShapeSequencerPanel : public juce::Component
+{
+public:
+    ShapeSequencerPanel(ShapeSequencer& sequencerToEdit, std::function<Curve()> getDrawnCurveFn,
+                        std::function<void(bool)> setEnabledFn)
+        : sequencer(sequencerToEdit), getDrawnCurve(std::move(getDrawnCurveFn)), setEnabled(std::move(setEnabledFn))
+    {
+        mode.addItemList({ "Sequencer off", "Sequencer on" }, 1);
+        mode.onChange = [this]()
+        {
+            setEnabled(mode.getSelectedId() == 2);
+            repaint();
+        };
+        addAndMakeVisible(mode);
+
+        for (int count = 1; count <= ShapeSequencer::maxSlots; ++count)
+            slotCount.addItem(juce::String(count) + (count == 1 ? " bar" : " bars"), count);
+        slotCount.onChange = [this]()
+        {
+            sequence.numSlots = slotCount.getSelectedId();
+            sequencer.setSequence(sequence);
+            repaint();
+        };
+        addAndMakeVisible(slotCount);
+
+        hint.setText("One slot per bar, looped. Click a slot to change it.", juce::dontSendNotification);
+        hint.setFont(juce::Font(12.0f));
+        hint.setColour(juce::Label::textColourId, juce::Colours::grey);
+        hint.setJustificationType(juce::Justification::topLeft);
+        addAndMakeVisible(hint);
+
+        refresh();
+    }
+
+    void refresh()
+    {
+        sequence = sequencer.getSequence();
+        mode.setSelectedId(sequencer.enabled.load() ? 2 : 1, juce::dontSendNotification);
+        slotCount.setSelectedId(sequence.numSlots, juce::dontSendNotification);
+        repaint();
+    }
+
+    void visibilityChanged() override
+    {
+        if (isVisible())
+            refresh(); // the drawn curve may have changed while hidden
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.setColour(juce::Colour(30, 30, 34));
+        g.fillRoundedRectangle(getLocalBounds().toFloat(), 4.0f);
+
+        const auto accent = juce::Colour(35, 247, 176).withAlpha(sequencer.enabled.load() ? 1.0f : 0.4f);
+        const Curve drawn = getDrawnCurve != nullptr ? getDrawnCurve() : Curve();
+        for (int s = 0; s < sequence.numSlots; ++s)
+        {
+            const auto cell = cellBounds(s);
+            const auto& slot = sequence.slots[(size_t)s];
+
+            g.setColour(juce::Colour(44, 44, 49));
+            g.fillRect(cell);
+
+            // a few cycles' worth of the shape, squeezed to the cell
+            const auto area = cell.reduced(2.0f, 4.0f).withTrimmedBottom(12.0f);
+            const double cycles = juce::jmin(4.0, (double)slot.cyclesPerBar);
+            juce::Path path;
+            for (int x = 0; x <= (int)area.getWidth(); ++x)
+            {
+                double p = cycles * x / juce::jmax(1.0f, area.getWidth());
+                p -= std::floor(p);
+                const float v = slot.shape == ShapeSequencer::Shape::Drawn ? drawn.sample((float)p) : previewAt(slot.shape, p);
+                const float y = area.getBottom() - area.getHeight() * juce::jlimit(0.0f, 1.0f, v);
+                if (x == 0) path.startNewSubPath(area.getX(), y);
+                else        path.lineTo(area.getX() + (float)x, y);
+            }
+            g.setColour(accent);
+            g.strokePath(path, juce::PathStrokeType(1.2f));
+
+            g.setColour(juce::Colours::grey);
+            g.setFont(10.0f);
+            g.drawText(rateName(slot.cyclesPerBar), cell.withTrimmedTop(cell.getHeight() - 13.0f), juce::Justification::centred);
+        }
+    }
+
+    void resized() override
+    {
+        auto r = getLocalBounds().reduced(6);
+        auto top = r.removeFromTop(24);
+        mode.setBounds(top.removeFromLeft(130));
+        top.removeFromLeft(6);
+        slotCount.setBounds(top.removeFromLeft(90));
+        r.removeFromTop(6);
+
+        hint.setBounds(r.removeFromBottom(18));
+        r.removeFromBottom(4);
+        cells = r;
+    }
+
+    void mouseDown(const juce::MouseEvent& e) override
+    {
+        for (int s = 0; s < sequence.numSlots; ++s)
+            if (cellBounds(s).contains(e.position))
+                showSlotMenu(s);
+    }
+
+private:
+    ShapeSequencer& sequencer;
+    std::function<Curve()> getDrawnCurve;
+    std::function<void(bool)> setEnabled;
+    ShapeSequencer::Sequence sequence; // the editor's copy, pushed on every edit
+
+    juce::ComboBox mode, slotCount;
+    juce::Label hint;
+    juce::Rectangle<int> cells;
+
+    static constexpr const char* shapeNames[] = { "Drawn curve", "Sine", "Triangle", "Saw", "Square", "Open" };
+
+    // two rows of eight
+    juce::Rectangle<float> cellBounds(int s) const
+    {
+        const float w = (float)cells.getWidth() / 8.0f;
+        const float h = (float)cells.getHeight() / 2.0f;
+        return juce::Rectangle<float>(cells.getX() + w * (float)(s % 8), cells.getY() + h * (float)(s / 8), w, h).reduced(1.5f);
+    }
+
+    static juce::String rateName(float cycles)
+    {
+        return cycles < 1.0f ? "1/" + juce::String(juce::roundToInt(1.0f / cycles)) : "x" + juce::String(juce::roundToInt(cycles));
+    }
+
+    static float previewAt(ShapeSequencer::Shape shape, double p)
+    {
+        switch (shape)
+        {
+        case ShapeSequencer::Shape::Sine:     return 0.5f + 0.5f * (float)std::sin(juce::MathConstants<double>::twoPi * p);
+        case ShapeSequencer::Shape::Triangle: return 1.0f - (float)std::abs(2.0 * p - 1.0);
+        case ShapeSequencer::Shape::Saw:      return (float)p;
+        case ShapeSequencer::Shape::Square:   return p < 0.5 ? 1.0f : 0.0f;
+        default:                              return 1.0f;
+        }
+    }
+
+    void showSlotMenu(int s)
+    {
+        const auto& slot = sequence.slots[(size_t)s];
+        juce::PopupMenu menu;
+        menu.addSectionHeader("Slot " + juce::String(s + 1));
+        for (int shape = 0; shape < (int)ShapeSequencer::Shape::numShapes; ++shape)
+            menu.addItem(1 + shape, shapeNames[shape], true, (int)slot.shape == shape);
+        menu.addSeparator();
+        for (size_t r = 0; r < ShapeSequencer::rates.size(); ++r)
+        {
+            const float cycles = ShapeSequencer::rates[r];
+            menu.addItem(100 + (int)r, rateName(cycles) + (cycles < 1.0f ? " (slower)" : " per bar"), true,
+                         slot.cyclesPerBar == cycles);
+        }
+
+        juce::Component::SafePointer<ShapeSequencerPanel> safeThis(this);
+        menu.showMenuAsync(juce::PopupMenu::Options().withTargetScreenArea(localAreaToGlobal(cellBounds(s).toNearestInt())),
+                           [safeThis, s](int result)
+                           {
+                               if (safeThis == nullptr || result == 0)
+                                   return;
+
+                               auto& edited = safeThis->sequence.slots[(size_t)s];
+                               if (result >= 100)
+                                   edited.cyclesPerBar = ShapeSequencer::rates[(size_t)(result - 100)];
+                               else
+                                   edited.shape = (ShapeSequencer::Shape)(result - 1);
+
+                               safeThis->sequencer.setSequence(safeThis->sequence);
+                               safeThis->repaint();
+                           });
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(ShapeSequencerPanel)
+};
@@ -0,0 +1,141 @@
+// Sidechain.h
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cmath>
+#include <vector>
+#include "Trace.h"
+
+// Envelope of the sidechain bus, turned into a per-sample depth scale for the LFO.
+// The detector takes the peak of every 16-sample step (FloatVectorOperations over each
+// channel), runs the attack/release follower once per step and ramps between the last
+// two step values, so the per-sample cost is a min/max scan and a ramp fill.
+//
+// amount > 0: depth follows the envelope (the gate ducks hardest on the kick)
+// amount < 0: depth backs off as the envelope rises (the gate opens up on the kick)
+class SidechainFollower
+{
+public:
+    static constexpr int decimation = 16;
+
+    // GUI writes, audio thread reads once per block
+    std::atomic<float> amount{ 0.0f };      // -1..1, 0 = off
+    std::atomic<float> attackMs{ 5.0f };
+    std::atomic<float> releaseMs{ 120.0f };
+
+    // audio thread writes, GUI reads for its meter
+    std::atomic<float> envelopeLevel{ 0.0f };
+
+    void prepare(double newSampleRate, int maxBlockSize)
+    {
+        sampleRate = newSampleRate;
+        depthScale.assign((size_t)juce::jmax(1, maxBlockSize), 1.0f);
+        reset();
+    }
+
+    void reset()
+    {
+        envelope = previous = 0.0f;
+        stepPeak = 0.0f;
+        stepFill = 0;
+        envelopeLevel = 0.0f;
+    }
+
+    // audio thread: true if the sidechain should shape this block at all
+    bool beginBlock(int numSidechainChannels)
+    {
+        blockAmount = juce::jlimit(-1.0f, 1.0f, amount.load(std::memory_order_relaxed));
+        if (!std::isfinite(blockAmount))
+            blockAmount = 0.0f;
+
+        const bool active = numSidechainChannels > 0 && blockAmount != 0.0f;
+        if (!active)
+        {
+            if (wasActive)
+                reset(); // start from silence next time rather than a stale envelope
+            wasActive = false;
+            return false;
+        }
+
+        const double stepRate = sampleRate / decimation;
+        attackCoeff = coefficient(attackMs.load(std::memory_order_relaxed), stepRate);
+        releaseCoeff = coefficient(releaseMs.load(std::memory_order_relaxed), stepRate);
+        wasActive = true;
+        return true;
+    }
+
+    // audio thread: depth scale (0..1) for samples [start, start + n) of the sidechain
+    const float* render(const juce::AudioBuffer<float>& sidechain, int start, int n)
+    {
+        CHRONOS_TRACE_SCOPE("SidechainFollower::render");
+        float* out = depthScale.data();
+        const int numChannels = sidechain.getNumChannels();
+
+        for (int pos = 0; pos < n;)
+        {
+            const int len = juce::jmin(decimation - stepFill, n - pos);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const auto range = juce::FloatVectorOperations::findMinAndMax(sidechain.getReadPointer(ch, start + pos), len);
+                stepPeak = juce::jmax(stepPeak, -range.getStart(), range.getEnd());
+            }
+
+            // one step behind, so the ramp always has both ends
+            const float step = (envelope - previous) / (float)decimation;
+            for (int i = 0; i < len; ++i)
+                out[pos + i] = previous + step * (float)(stepFill + i);
+
+            stepFill += len;
+            pos += len;
+
+            if (stepFill == decimation)
+            {
+                previous = envelope;
+                const float coeff = stepPeak > envelope ? attackCoeff : releaseCoeff;
+                envelope = stepPeak + coeff * (envelope - stepPeak);
+                stepPeak = 0.0f;
+                stepFill = 0;
+            }
+        }
+
+        envelopeLevel.store(envelope, std::memory_order_relaxed);
+
+        // envelope -> depth scale
+        juce::FloatVectorOperations::clip(out, out, 0.0f, 1.0f, n);
+        if (blockAmount > 0.0f)
+        {
+            // (1 - a) + a * e
+            juce::FloatVectorOperations::multiply(out, blockAmount, n);
+            juce::FloatVectorOperations::add(out, 1.0f - blockAmount, n);
+        }
+        else
+        {
+            // 1 - |a| * e
+            juce::FloatVectorOperations::multiply(out, blockAmount, n);
+            juce::FloatVectorOperations::add(out, 1.0f, n);
+        }
+        return out;
+    }
+
+private:
+    double sampleRate = 44100.0;
+    std::vector<float> depthScale = std::vector<float>(512, 1.0f);
+
+    // audio thread
+    float blockAmount = 0.0f;
+    float attackCoeff = 0.0f, releaseCoeff = 0.0f;
+    float envelope = 0.0f, previous = 0.0f;
+    float stepPeak = 0.0f;
+    int stepFill = 0;
+    bool wasActive = false;
+
+    static float coefficient(float ms, double rate)
+    {
+        if (!std::isfinite(ms) || ms <= 0.0f)
+            return 0.0f;
+        return (float)std::exp(-1.0 / (rate * ms * 0.001));
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(SidechainFollower)
+};
@@ -0,0 +1,177 @@
+// SidechainPanel.h
+#pragma once
+#include <JuceHeader.h>
+#include <functional>
+#include "Sidechain.h"
+#include "OnsetDetector.h"
+
+// Amount / attack / release for the processor's SidechainFollower, plus a meter of the
+// envelope it's following, and the transient retrigger settings (which can listen to the
+// sidechain or the main input). Says so when the host hasn't routed anything to the sidechain.
+class SidechainPanel : public juce::Component,
+                       private juce::Timer
+{
+public:
+    SidechainPanel(SidechainFollower& followerToEdit, OnsetDetector& onsetsToEdit, std::function<bool()> isConnectedFn)
+        : follower(followerToEdit), onsets(onsetsToEdit), isConnected(std::move(isConnectedFn))
+    {
+        style(amount);
+        amount.setRange(-100.0, 100.0, 1.0);
+        amount.setTextValueSuffix("% sidechain depth");
+        amount.setDoubleClickReturnValue(true, 0.0);
+        amount.onValueChange = [this]() { follower.amount = (float)amount.getValue() / 100.0f; };
+        addAndMakeVisible(amount);
+
+        style(attack);
+        attack.setRange(0.1, 200.0, 0.1);
+        attack.setSkewFactorFromMidPoint(10.0);
+        attack.setTextValueSuffix(" ms attack");
+        attack.onValueChange = [this]() { follower.attackMs = (float)attack.getValue(); };
+        addAndMakeVisible(attack);
+
+        style(release);
+        release.setRange(5.0, 2000.0, 1.0);
+        release.setSkewFactorFromMidPoint(150.0);
+        release.setTextValueSuffix(" ms release");
+        release.onValueChange = [this]() { follower.releaseMs = (float)release.getValue(); };
+        addAndMakeVisible(release);
+
+        retrigger.addItemList({ "No retrigger", "Retrig: input", "Retrig: SC" }, 1);
+        retrigger.onChange = [this]() { onsets.source = retrigger.getSelectedId() - 1; };
+        addAndMakeVisible(retrigger);
+
+        style(onsetSensitivity);
+        onsetSensitivity.setRange(0.0, 100.0, 1.0);
+        onsetSensitivity.setTextValueSuffix("% sens");
+        onsetSensitivity.onValueChange = [this]() { onsets.sensitivity = (float)onsetSensitivity.getValue() / 100.0f; };
+        addAndMakeVisible(onsetSensitivity);
+
+        style(onsetHold);
+        onsetHold.setRange(10.0, 1000.0, 1.0);
+        onsetHold.setSkewFactorFromMidPoint(120.0);
+        onsetHold.setTextValueSuffix(" ms hold");
+        onsetHold.onValueChange = [this]() { onsets.refractoryMs = (float)onsetHold.getValue(); };
+        addAndMakeVisible(onsetHold);
+
+        hint.setFont(juce::Font(12.0f));
+        hint.setColour(juce::Label::textColourId, juce::Colours::grey);
+        hint.setJustificationType(juce::Justification::topLeft);
+        addAndMakeVisible(hint);
+
+        refresh();
+    }
+
+    void refresh()
+    {
+        amount.setValue(follower.amount.load() * 100.0, juce::dontSendNotification);
+        attack.setValue(follower.attackMs.load(), juce::dontSendNotification);
+        release.setValue(follower.releaseMs.load(), juce::dontSendNotification);
+        retrigger.setSelectedId(juce::jlimit(0, 2, onsets.source.load()) + 1, juce::dontSendNotification);
+        onsetSensitivity.setValue(onsets.sensitivity.load() * 100.0, juce::dontSendNotification);
+        onsetHold.setValue(onsets.refractoryMs.load(), juce::dontSendNotification);
+        seenOnsets = onsets.onsetCount.load();
+        updateHint();
+    }
+
+    void visibilityChanged() override
+    {
+        if (isVisible()) { refresh(); startTimerHz(30); }
+        else             stopTimer();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.setColour(juce::Colour(30, 30, 34));
+        g.fillRoundedRectangle(getLocalBounds().toFloat(), 4.0f);
+
+        g.setColour(juce::Colour(44, 44, 49));
+        g.fillRect(meterBounds);
+        g.setColour(juce::Colour(35, 247, 176));
+        g.fillRect(meterBounds.withWidth(meterBounds.getWidth() * juce::jlimit(0.0f, 1.0f, shownLevel)));
+
+        // blinks on every retrigger
+        if (flash > 0.0f)
+        {
+            g.setColour(juce::Colour(238, 99, 82).withAlpha(flash));
+            g.fillEllipse(flashBounds);
+        }
+    }
+
+    void resized() override
+    {
+        auto r = getLocalBounds().reduced(6);
+        for (auto* s : { &amount, &attack, &release })
+        {
+            s->setBounds(r.removeFromTop(24));
+            r.removeFromTop(6);
+        }
+        meterBounds = r.removeFromTop(8).toFloat();
+        r.removeFromTop(6);
+
+        auto row = r.removeFromTop(24);
+        flashBounds = row.removeFromRight(12).withSizeKeepingCentre(8, 8).toFloat();
+        row.removeFromRight(4);
+        retrigger.setBounds(row.removeFromLeft(104));
+        row.removeFromLeft(4);
+        onsetSensitivity.setBounds(row.removeFromLeft((row.getWidth() - 4) / 2));
+        row.removeFromLeft(4);
+        onsetHold.setBounds(row);
+
+        r.removeFromTop(4);
+        hint.setBounds(r);
+    }
+
+private:
+    SidechainFollower& follower;
+    OnsetDetector& onsets;
+    std::function<bool()> isConnected;
+
+    juce::Slider amount, attack, release;
+    juce::ComboBox retrigger;
+    juce::Slider onsetSensitivity, onsetHold;
+    juce::Label hint;
+    juce::Rectangle<float> meterBounds, flashBounds;
+    float shownLevel = 0.0f;
+    float flash = 0.0f;
+    juce::uint32 seenOnsets = 0;
+    bool shownConnected = false;
+
+    static void style(juce::Slider& s)
+    {
+        s.setSliderStyle(juce::Slider::LinearBar);
+        s.setColour(juce::Slider::trackColourId, juce::Colour(35, 247, 176).withAlpha(0.6f));
+        s.setColour(juce::Slider::backgroundColourId, juce::Colour(44, 44, 49));
+        s.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+    }
+
+    void updateHint()
+    {
+        shownConnected = isConnected != nullptr && isConnected();
+        hint.setText(shownConnected ? "Depth: + ducks harder on hits, - opens up on hits"
+                                    : "No sidechain routed: send a track to Chronos' sidechain input.",
+                     juce::dontSendNotification);
+    }
+
+    void timerCallback() override
+    {
+        const float level = follower.envelopeLevel.load(std::memory_order_relaxed);
+        if (std::abs(level - shownLevel) > 0.002f)
+        {
+            shownLevel = level;
+            repaint(meterBounds.toNearestInt().expanded(1));
+        }
+
+        const auto count = onsets.onsetCount.load(std::memory_order_relaxed);
+        if (count != seenOnsets || flash > 0.0f)
+        {
+            flash = count != seenOnsets ? 1.0f : (flash > 0.05f ? flash * 0.7f : 0.0f);
+            seenOnsets = count;
+            repaint(flashBounds.toNearestInt().expanded(1));
+        }
+
+        if ((isConnected != nullptr && isConnected()) != shownConnected)
+            updateHint();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(SidechainPanel)
+};
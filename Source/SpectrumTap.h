@@ -0,0 +1,76 @@
+// SpectrumTap.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <algorithm>
+
+// Where the spectrum view gets its audio from. processBlock copies a mono mix of its input
+// and of its output into two lock-free rings, and that's all the audio thread does: the FFTs
+// run on the view's own worker. Nothing is copied unless a view has switched the tap on,
+// so a closed (or hidden) spectrum costs one atomic load per block.
+class SpectrumTap
+{
+public:
+    enum Stream { input = 0, output = 1 };
+    static constexpr int ringSize = 1 << 14; // ~1/3 s at 48k, the worker reads every frame
+
+    void prepare(double newSampleRate) { sampleRate = newSampleRate; }
+    double getSampleRate() const { return sampleRate.load(); }
+
+    // view: start/stop copying
+    void setActive(bool shouldBeActive) { active = shouldBeActive; }
+    bool isActive() const { return active.load(std::memory_order_relaxed); }
+
+    // audio thread
+    void push(Stream stream, const juce::AudioBuffer<float>& buffer, int numChannels)
+    {
+        numChannels = juce::jmin(numChannels, buffer.getNumChannels());
+        if (!isActive() || numChannels <= 0)
+            return;
+
+        auto& ring = rings[(size_t)stream];
+        auto scope = ring.fifo.write(buffer.getNumSamples()); // short if the worker is behind
+        mixDown(ring.samples.data() + scope.startIndex1, buffer, 0, scope.blockSize1, numChannels);
+        mixDown(ring.samples.data() + scope.startIndex2, buffer, scope.blockSize1, scope.blockSize2, numChannels);
+    }
+
+    // worker: up to maxSamples of the oldest samples waiting, returns how many
+    int read(Stream stream, float* dest, int maxSamples)
+    {
+        auto& ring = rings[(size_t)stream];
+        auto scope = ring.fifo.read(juce::jmin(maxSamples, ring.fifo.getNumReady()));
+        std::copy_n(ring.samples.begin() + scope.startIndex1, scope.blockSize1, dest);
+        std::copy_n(ring.samples.begin() + scope.startIndex2, scope.blockSize2, dest + scope.blockSize1);
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    // worker: throw away whatever piled up (e.g. from before the view was last shown)
+    void discard(Stream stream)
+    {
+        auto& ring = rings[(size_t)stream];
+        ring.fifo.read(ring.fifo.getNumReady());
+    }
+
+private:
+    struct Ring
+    {
+        juce::AbstractFifo fifo{ ringSize };
+        std::array<float, ringSize> samples{};
+    };
+
+    std::array<Ring, 2> rings;
+    std::atomic<bool> active{ false };
+    std::atomic<double> sampleRate{ 44100.0 };
+
+    static void mixDown(float* dest, const juce::AudioBuffer<float>& buffer, int offset, int n, int numChannels)
+    {
+        if (n <= 0)
+            return;
+
+        const float scale = 1.0f / (float)numChannels;
+        juce::FloatVectorOperations::copyWithMultiply(dest, buffer.getReadPointer(0, offset), scale, n);
+        for (int ch = 1; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::addWithMultiply(dest, buffer.getReadPointer(ch, offset), scale, n);
+    }
+};
@@ -0,0 +1,231 @@
+// SpectrumView.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include "SpectrumTap.h"
+#include "TripleBuffer.h"
+
+// Input vs output spectrum. The view owns the FFT worker: every display frame it wakes the
+// worker, which pulls what the tap collected, runs a Hann-windowed FFT per stream, smooths
+// the magnitudes and publishes them through a TripleBuffer for the next paint. While the
+// view is hidden or gone the worker sleeps and the tap is switched off.
+class SpectrumView : public juce::Component,
+                     private juce::Timer
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBins = fftSize / 2;
+
+    explicit SpectrumView(SpectrumTap& tapToShow) : tap(tapToShow), worker(tapToShow, frames)
+    {
+        setInterceptsMouseClicks(false, false);
+    }
+
+    ~SpectrumView() override
+    {
+        stop();
+    }
+
+    void visibilityChanged() override
+    {
+        if (isShowing()) start();
+        else             stop();
+    }
+
+    void parentHierarchyChanged() override { visibilityChanged(); }
+
+    void paint(juce::Graphics& g) override
+    {
+        auto r = getLocalBounds().toFloat();
+        g.setColour(juce::Colour(30, 30, 34));
+        g.fillRoundedRectangle(r, 4.0f);
+        r = r.reduced(6.0f, 4.0f);
+
+        // a line per decade: 100 Hz, 1k, 10k
+        g.setColour(juce::Colours::grey.withAlpha(0.2f));
+        for (float f = 100.0f; f < maxHz; f *= 10.0f)
+            g.drawVerticalLine((int)xForHz(f, r), r.getY(), r.getBottom());
+
+        const auto& frame = frames.getReadBuffer();
+        if (!frame.valid)
+            return;
+
+        auto input = pathFor(frame.input, r, frame.sampleRate);
+        auto output = pathFor(frame.output, r, frame.sampleRate);
+
+        juce::Path inputFill(input);
+        inputFill.lineTo(r.getRight(), r.getBottom());
+        inputFill.lineTo(r.getX(), r.getBottom());
+        inputFill.closeSubPath();
+        g.setColour(juce::Colour(74, 154, 211).withAlpha(0.35f)); // input, filled
+        g.fillPath(inputFill);
+
+        g.setColour(juce::Colour(40, 246, 177)); // output, line
+        g.strokePath(output, juce::PathStrokeType(1.5f));
+
+        g.setColour(juce::Colours::white.withAlpha(0.6f));
+        g.setFont(11.0f);
+        g.drawText("in", getLocalBounds().reduced(8, 4).removeFromTop(12), juce::Justification::topRight);
+        g.setColour(juce::Colour(40, 246, 177));
+        g.drawText("out", getLocalBounds().reduced(8, 4).withTrimmedTop(12).removeFromTop(12), juce::Justification::topRight);
+    }
+
+private:
+    static constexpr float minHz = 20.0f, maxHz = 20000.0f;
+    static constexpr float floorDb = -90.0f;
+
+    struct Frame
+    {
+        std::array<float, numBins> input{}, output{}; // smoothed dB
+        double sampleRate = 44100.0;
+        bool valid = false;
+    };
+
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker(SpectrumTap& t, TripleBuffer<Frame>& f) : juce::Thread("Spectrum"), tap(t), frames(f)
+        {
+            for (auto* h : { &inputHistory, &outputHistory })
+                h->assign((size_t)fftSize, 0.0f);
+            fftData.assign((size_t)fftSize * 2, 0.0f);
+            smoothedInput.fill(floorDb);
+            smoothedOutput.fill(floorDb);
+        }
+
+        void run() override
+        {
+            tap.discard(SpectrumTap::input);
+            tap.discard(SpectrumTap::output);
+
+            while (!threadShouldExit())
+            {
+                wait(-1); // one pass per display frame, woken by the view's timer
+                if (threadShouldExit())
+                    break;
+
+                const bool newInput = pull(SpectrumTap::input, inputHistory);
+                const bool newOutput = pull(SpectrumTap::output, outputHistory);
+                if (!newInput && !newOutput)
+                    continue;
+
+                analyse(inputHistory, smoothedInput);
+                analyse(outputHistory, smoothedOutput);
+
+                auto& frame = frames.getWriteBuffer();
+                frame.input = smoothedInput;
+                frame.output = smoothedOutput;
+                frame.sampleRate = tap.getSampleRate();
+                frame.valid = true;
+                frames.publish();
+            }
+        }
+
+    private:
+        SpectrumTap& tap;
+        TripleBuffer<Frame>& frames;
+
+        juce::dsp::FFT fft{ fftOrder };
+        juce::dsp::WindowingFunction<float> window{ (size_t)fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+        std::vector<float> inputHistory, outputHistory, fftData, incoming = std::vector<float>(SpectrumTap::ringSize);
+        std::array<float, numBins> smoothedInput, smoothedOutput;
+
+        // slides the newest samples into the last fftSize of history
+        bool pull(SpectrumTap::Stream stream, std::vector<float>& history)
+        {
+            const int n = tap.read(stream, incoming.data(), (int)incoming.size());
+            if (n <= 0)
+                return false;
+
+            const int keep = juce::jmax(0, fftSize - n);
+            std::move(history.end() - keep, history.end(), history.begin());
+            std::copy(incoming.begin() + (n - (fftSize - keep)), incoming.begin() + n, history.begin() + keep);
+            return true;
+        }
+
+        void analyse(const std::vector<float>& history, std::array<float, numBins>& smoothed)
+        {
+            std::copy(history.begin(), history.end(), fftData.begin());
+            std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+            window.multiplyWithWindowingTable(fftData.data(), (size_t)fftSize);
+            fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+            // Hann's coherent gain is 1/2, so a full-scale sine reads about 0 dB
+            const float scale = 4.0f / (float)fftSize;
+            for (size_t i = 0; i < (size_t)numBins; ++i)
+            {
+                const float db = juce::Decibels::gainToDecibels(fftData[i] * scale, floorDb);
+                // fast attack, slower fall
+                smoothed[i] += (db > smoothed[i] ? 0.6f : 0.15f) * (db - smoothed[i]);
+            }
+        }
+    };
+
+    SpectrumTap& tap;
+    TripleBuffer<Frame> frames;
+    Worker worker;
+    bool running = false;
+
+    void start()
+    {
+        if (running)
+            return;
+
+        running = true;
+        tap.setActive(true);
+        worker.startThread(juce::Thread::Priority::low);
+        startTimerHz(30);
+    }
+
+    void stop()
+    {
+        if (!running)
+            return;
+
+        running = false;
+        stopTimer();
+        tap.setActive(false);
+        worker.signalThreadShouldExit();
+        worker.notify();
+        worker.stopThread(1000);
+    }
+
+    void timerCallback() override
+    {
+        worker.notify(); // analyse what came in since the last frame
+        if (frames.acquire())
+            repaint();
+    }
+
+    float xForHz(float hz, juce::Rectangle<float> r) const
+    {
+        return r.getX() + r.getWidth() * std::log(hz / minHz) / std::log(maxHz / minHz);
+    }
+
+    // one point per couple of pixels, taking the loudest bin each covers
+    juce::Path pathFor(const std::array<float, numBins>& db, juce::Rectangle<float> r, double sampleRate) const
+    {
+        juce::Path p;
+        const float binHz = (float)sampleRate / (float)fftSize;
+        const int numPoints = juce::jmax(2, (int)r.getWidth() / 2);
+
+        for (int i = 0; i < numPoints; ++i)
+        {
+            const float f0 = minHz * std::pow(maxHz / minHz, (float)i / (float)numPoints);
+            const float f1 = minHz * std::pow(maxHz / minHz, (float)(i + 1) / (float)numPoints);
+            const int b0 = juce::jlimit(1, numBins - 1, (int)(f0 / binHz));
+            const int b1 = juce::jlimit(b0, numBins - 1, (int)(f1 / binHz));
+
+            float level = floorDb;
+            for (int b = b0; b <= b1; ++b)
+                level = juce::jmax(level, db[(size_t)b]);
+
+            const juce::Point<float> pt{ xForHz(f0, r), juce::jmap(level, floorDb, 0.0f, r.getBottom(), r.getY()) };
+            if (i == 0) p.startNewSubPath(pt);
+            else        p.lineTo(pt);
+        }
+        return p;
+    }
+};
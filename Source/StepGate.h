@@ -0,0 +1,235 @@
+// StepGate.h
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include "TripleBuffer.h"
+#include "Trace.h"
+
+// Classic 16/32-step trance gate, one pattern per bar of the host timeline. Each step has a
+// level, a length (how much of the step the gate stays open) and a tie into the next step.
+//
+// The message thread compiles the pattern into a sorted list of breakpoints across the bar
+// (the gain is a straight line between two of them, with short ramps at every edge so
+// nothing clicks) and hands it over through a TripleBuffer. The audio thread just finds
+// the segment it's in and fills runs: FloatVectorOperations::fill while the gate holds, a
+// short ramp at the edges. No per-sample shape evaluation.
+class StepGate
+{
+public:
+    static constexpr int maxSteps = 32;
+
+    struct Step
+    {
+        float level = 1.0f;  // 0..1
+        float length = 0.5f; // 0..1 of the step
+        bool tie = false;    // stays open into the next step
+    };
+
+    struct Pattern
+    {
+        int numSteps = 16; // 16 or 32
+        std::array<Step, maxSteps> steps{};
+    };
+
+    std::atomic<bool> enabled{ false }; // GUI writes, audio thread reads once per block
+
+    StepGate() { setPattern(Pattern()); }
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        freePosition = 0.0;
+    }
+
+    // message thread: keeps the pattern and publishes it compiled
+    void setPattern(const Pattern& newPattern)
+    {
+        const juce::SpinLock::ScopedLockType lock(writerLock); // only ever taken by writers
+        pattern = newPattern;
+        pattern.numSteps = pattern.numSteps > 16 ? maxSteps : 16;
+        compile(pattern, breakpoints.getWriteBuffer());
+        breakpoints.publish();
+    }
+
+    Pattern getPattern() const
+    {
+        const juce::SpinLock::ScopedLockType lock(writerLock);
+        return pattern;
+    }
+
+    // audio thread: where in the bar this block starts. Returns false if the gate is off.
+    bool beginBlock(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position, int numSamples, float hostBpm)
+    {
+        breakpoints.acquire();
+        if (!enabled.load(std::memory_order_relaxed))
+            return false;
+
+        // bar length from the host's time signature, 4/4 if it doesn't say
+        double barBeats = 4.0;
+        if (position && position->getTimeSignature())
+        {
+            const auto sig = *position->getTimeSignature();
+            if (sig.numerator > 0 && sig.denominator > 0)
+                barBeats = 4.0 * sig.numerator / sig.denominator;
+        }
+
+        const double beatSamples = sampleRate * 60.0 / juce::jmax(1.0f, hostBpm);
+        barIncrement = 1.0 / (barBeats * beatSamples);
+
+        // the host's PPQ when it's playing, our own count when it isn't
+        double beats = freePosition / beatSamples;
+        if (position && position->getIsPlaying() && position->getPpqPosition())
+        {
+            beats = *position->getPpqPosition();
+            if (position->getPpqPositionOfLastBarStart())
+                beats -= *position->getPpqPositionOfLastBarStart();
+            freePosition = *position->getPpqPosition() * beatSamples;
+        }
+        freePosition += numSamples;
+
+        barPos = beats / barBeats;
+        barPos -= std::floor(barPos);
+        return true;
+    }
+
+    // audio thread: gate values (0..1) for the next n samples
+    void render(float* dest, int n)
+    {
+        CHRONOS_TRACE_SCOPE("StepGate::render");
+        const auto& compiled = breakpoints.getReadBuffer();
+        if (compiled.count < 2)
+        {
+            juce::FloatVectorOperations::fill(dest, 0.0f, n);
+            return;
+        }
+
+        const auto* first = compiled.points.data();
+        const auto* last = first + compiled.count;
+
+        for (int i = 0; i < n;)
+        {
+            // the segment [a, b) we're in
+            const auto* b = std::upper_bound(first, last, barPos, [](double p, const Point& pt) { return p < pt.pos; });
+            b = juce::jlimit(first + 1, last - 1, b);
+            const auto* a = b - 1;
+
+            const double span = b->pos - a->pos;
+            const int len = juce::jlimit(1, n - i, (int)std::ceil((b->pos - barPos) / barIncrement));
+
+            if (a->value == b->value || span <= 0.0)
+            {
+                juce::FloatVectorOperations::fill(dest + i, a->value, len);
+            }
+            else
+            {
+                const double slope = (b->value - a->value) / span;
+                const float start = (float)(a->value + slope * (barPos - a->pos));
+                const float step = (float)(slope * barIncrement);
+                for (int k = 0; k < len; ++k)
+                    dest[i + k] = start + step * (float)k;
+            }
+
+            barPos += len * barIncrement;
+            if (barPos >= 1.0)
+                barPos -= 1.0;
+            i += len;
+        }
+    }
+
+private:
+    static constexpr double edge = 1.0 / 1024.0; // ramp at every edge, in bars (about 2 ms at 120 BPM)
+
+    struct Point
+    {
+        double pos = 0.0; // 0..1 across the bar
+        float value = 0.0f;
+    };
+
+    // every step can add a start and an end, each a ramp (two points), plus both ends of the bar
+    struct Breakpoints
+    {
+        std::array<Point, maxSteps * 4 + 2> points{};
+        int count = 0;
+    };
+
+    struct Event
+    {
+        double pos = 0.0;
+        float target = 0.0f;
+    };
+
+    static void compile(const Pattern& p, Breakpoints& out)
+    {
+        const int numSteps = p.numSteps;
+        const double stepWidth = 1.0 / numSteps;
+
+        auto isOpen = [&p](int s) { return p.steps[(size_t)s].level > 0.0f && (p.steps[(size_t)s].tie || p.steps[(size_t)s].length > 0.0f); };
+        auto endOf = [&](int s)
+        {
+            const auto& step = p.steps[(size_t)s];
+            const double open = step.tie ? 1.0 : juce::jlimit(0.0, 1.0, (double)step.length);
+            return s * stepWidth + juce::jmax(open * stepWidth, 2.0 * edge);
+        };
+
+        // where the gain changes and to what: a step opening, or closing if the next one
+        // doesn't pick up where it ends (a tie or a full-length step runs straight on)
+        std::array<Event, maxSteps * 2> events;
+        int numEvents = 0;
+        for (int s = 0; s < numSteps; ++s)
+        {
+            if (!isOpen(s))
+                continue;
+
+            events[(size_t)numEvents++] = { s * stepWidth, juce::jlimit(0.0f, 1.0f, p.steps[(size_t)s].level) };
+
+            const int next = (s + 1) % numSteps;
+            const double end = endOf(s);
+            if (!(isOpen(next) && end >= (s + 1) * stepWidth))
+                events[(size_t)numEvents++] = { end >= 1.0 ? end - 1.0 : end, 0.0f };
+        }
+        std::sort(events.begin(), events.begin() + numEvents, [](const Event& x, const Event& y) { return x.pos < y.pos; });
+
+        int count = 0;
+        auto add = [&out, &count](double pos, float value) { out.points[(size_t)count++] = { pos, value }; };
+
+        if (numEvents == 0)
+        {
+            add(0.0, 0.0f);
+            add(1.0, 0.0f);
+            out.count = count;
+            return;
+        }
+
+        // the bar starts where the last event of the previous one left it
+        float value = events[(size_t)numEvents - 1].target;
+        add(0.0, value);
+
+        for (int e = 0; e < numEvents; ++e)
+        {
+            const auto& event = events[(size_t)e];
+            const double limit = e + 1 < numEvents ? events[(size_t)e + 1].pos : 1.0;
+            const double rampEnd = juce::jmin(event.pos + edge, limit);
+            const float reached = value + (event.target - value) * (float)((rampEnd - event.pos) / edge);
+
+            add(event.pos, value);
+            add(rampEnd, reached);
+            value = reached;
+        }
+        add(1.0, value);
+        out.count = count;
+    }
+
+    Pattern pattern; // message thread copy, for the editor and the saved state
+    mutable juce::SpinLock writerLock;
+    TripleBuffer<Breakpoints> breakpoints;
+
+    // audio thread
+    double sampleRate = 44100.0;
+    double barPos = 0.0, barIncrement = 0.0;
+    double freePosition = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE(StepGate)
+};
@@ -0,0 +1,135 @@
+// StepGatePanel.h
+#pragma once
+#include <JuceHeader.h>
+#include "StepGate.h"
+
+// On/off and step count for the processor's StepGate, and the pattern itself: drag in the
+// top row for each step's level, in the middle row for how much of the step stays open,
+// click the bottom row to tie a step into the next. Every edit recompiles the pattern
+// (cheap, message thread); refresh() pulls it back after a state load.
+class StepGatePanel : public juce::Component
+{
+public:
+    explicit StepGatePanel(StepGate& gateToEdit) : gate(gateToEdit)
+    {
+        mode.addItemList({ "Step gate off", "16 steps", "32 steps" }, 1);
+        mode.onChange = [this]()
+        {
+            gate.enabled = mode.getSelectedId() > 1;
+            if (mode.getSelectedId() > 1)
+            {
+                pattern.numSteps = mode.getSelectedId() == 3 ? StepGate::maxSteps : 16;
+                gate.setPattern(pattern);
+            }
+            repaint();
+        };
+        addAndMakeVisible(mode);
+
+        refresh();
+    }
+
+    void refresh()
+    {
+        pattern = gate.getPattern();
+        mode.setSelectedId(gate.enabled.load() ? (pattern.numSteps > 16 ? 3 : 2) : 1, juce::dontSendNotification);
+        repaint();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.setColour(juce::Colour(30, 30, 34));
+        g.fillRoundedRectangle(getLocalBounds().toFloat(), 4.0f);
+
+        const auto accent = juce::Colour(35, 247, 176);
+        const float alpha = gate.enabled.load() ? 1.0f : 0.4f;
+
+        for (int s = 0; s < pattern.numSteps; ++s)
+        {
+            const auto& step = pattern.steps[(size_t)s];
+
+            auto level = stepBounds(levelRow, s);
+            g.setColour(juce::Colour(44, 44, 49));
+            g.fillRect(level);
+            g.setColour(accent.withAlpha(0.8f * alpha));
+            g.fillRect(level.withTop(level.getBottom() - level.getHeight() * step.level));
+
+            auto length = stepBounds(lengthRow, s);
+            g.setColour(juce::Colour(44, 44, 49));
+            g.fillRect(length);
+            g.setColour(accent.withAlpha(0.5f * alpha));
+            g.fillRect(length.withTop(length.getBottom() - length.getHeight() * (step.tie ? 1.0f : step.length)));
+
+            auto tie = stepBounds(tieRow, s);
+            g.setColour(step.tie ? accent.withAlpha(alpha) : juce::Colour(44, 44, 49));
+            g.fillRect(tie);
+        }
+    }
+
+    void resized() override
+    {
+        auto r = getLocalBounds().reduced(6);
+        mode.setBounds(r.removeFromTop(24).removeFromLeft(120));
+        r.removeFromTop(6);
+
+        tieRow = r.removeFromBottom(10);
+        r.removeFromBottom(4);
+        lengthRow = r.removeFromBottom(26);
+        r.removeFromBottom(4);
+        levelRow = r;
+    }
+
+    void mouseDown(const juce::MouseEvent& e) override
+    {
+        const auto p = e.getPosition();
+        dragRow = levelRow.contains(p) ? &levelRow : lengthRow.contains(p) ? &lengthRow : tieRow.contains(p) ? &tieRow : nullptr;
+
+        if (dragRow == &tieRow)
+        {
+            const int s = stepAt(p.x);
+            tieValue = !pattern.steps[(size_t)s].tie; // the drag paints this onto every step it crosses
+        }
+        mouseDrag(e);
+    }
+
+    void mouseDrag(const juce::MouseEvent& e) override
+    {
+        if (dragRow == nullptr)
+            return;
+
+        const int s = stepAt(e.x);
+        auto& step = pattern.steps[(size_t)s];
+        const float y = juce::jlimit(0.0f, 1.0f, (float)(dragRow->getBottom() - e.y) / (float)juce::jmax(1, dragRow->getHeight()));
+
+        if (dragRow == &levelRow)       step.level = y;
+        else if (dragRow == &lengthRow) step.length = y;
+        else                            step.tie = tieValue;
+
+        gate.setPattern(pattern);
+        repaint();
+    }
+
+    void mouseUp(const juce::MouseEvent&) override { dragRow = nullptr; }
+
+private:
+    StepGate& gate;
+    StepGate::Pattern pattern; // the editor's copy, pushed to the gate on every edit
+
+    juce::ComboBox mode;
+    juce::Rectangle<int> levelRow, lengthRow, tieRow;
+    const juce::Rectangle<int>* dragRow = nullptr;
+    bool tieValue = false;
+
+    juce::Rectangle<float> stepBounds(const juce::Rectangle<int>& row, int s) const
+    {
+        const float w = (float)row.getWidth() / (float)pattern.numSteps;
+        return { row.getX() + w * (float)s + 1.0f, (float)row.getY(), juce::jmax(1.0f, w - 2.0f), (float)row.getHeight() };
+    }
+
+    int stepAt(int x) const
+    {
+        const int s = (int)((float)(x - levelRow.getX()) * (float)pattern.numSteps / (float)juce::jmax(1, levelRow.getWidth()));
+        return juce::jlimit(0, pattern.numSteps - 1, s);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(StepGatePanel)
+};
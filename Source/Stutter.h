@@ -0,0 +1,212 @@
+// Stutter.h
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cmath>
+#include <vector>
+#include "LFO.h"
+#include "Trace.h"
+
+// Beat repeat. Everything that comes in is written to a circular buffer; the timeline is cut
+// into cycles of 'repeats' slices (slice = 1/16 .. 1/1 note) starting on the host's PPQ grid.
+// The first slice of a cycle plays live, the rest replay it (optionally backwards). Each slice
+// gets the drawn curve across its length, as the LFO value, and a 2 ms fade at both ends so
+// the jumps don't click.
+//
+// The buffer is sized in prepare() for 8 beats at 60 BPM (twice that at 120, and so on) and
+// one channel per main bus channel. A cycle (slice x repeats) longer than that gets its
+// repeats cut down to what fits, and playingRepeats tells the panel so. Nothing allocates
+// while playing.
+class Stutter
+{
+public:
+    enum class Mode { Off, Gate, Envelope }; // Gate: the curve above/below 0.5 cuts the slice on/off
+
+    static constexpr double maxSliceBeats = 4.0; // 1/1
+    static constexpr double ringBeats = 8.0;     // what the ring holds at ringBpm: a 1/1 slice and its replay
+    static constexpr double ringBpm = 60.0;
+
+    // GUI writes, audio thread reads once per block
+    std::atomic<int> mode{ (int)Mode::Off };
+    std::atomic<int> sliceDenominator{ 16 }; // 1, 2, 4, 8 or 16
+    std::atomic<int> repeats{ 4 };           // plays of each slice per cycle, the live one included
+    std::atomic<bool> reverse{ false };
+
+    // audio thread writes: the repeats actually playing (0 while off), less than 'repeats' when cut
+    std::atomic<int> playingRepeats{ 0 };
+
+    // numChannels: the main bus width, the only channels process() is ever given
+    void prepare(double newSampleRate, int maxBlockSize, int numChannels)
+    {
+        sampleRate = newSampleRate;
+        maxBlock = juce::jmax(1, maxBlockSize);
+
+        const double beatSamples = sampleRate * 60.0 / ringBpm;
+        capacity = (int)std::ceil(ringBeats * beatSamples) + maxBlock + 2;
+        ring.setSize(juce::jmax(1, numChannels), capacity);
+
+        slicePhase.assign((size_t)maxBlock, 0.0);
+        fade.assign((size_t)maxBlock, 1.0f);
+        fadeRate = 1.0 / (sampleRate * 0.002);
+        reset();
+    }
+
+    void reset()
+    {
+        ring.clear();
+        writePos = 0;
+        freePosition = 0.0;
+    }
+
+    // audio thread: where this block sits on the grid. 'latency' is how late the audio
+    // reaching process() is against the host timeline (the lookahead delay). Returns false
+    // if stutter is off.
+    bool beginBlock(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position, int numSamples,
+                    float hostBpm, int latency)
+    {
+        blockMode = (Mode)juce::jlimit(0, 2, mode.load(std::memory_order_relaxed));
+        if (blockMode == Mode::Off || capacity <= 0)
+        {
+            if (wasActive)
+                reset();
+            wasActive = false;
+            playingRepeats.store(0, std::memory_order_relaxed);
+            return false;
+        }
+
+        const double beatSamples = sampleRate * 60.0 / juce::jmax(1.0f, hostBpm);
+        const int denominator = juce::jlimit(1, 16, sliceDenominator.load(std::memory_order_relaxed));
+        sliceSamples = beatSamples * 4.0 / denominator;
+
+        // the furthest back a replay reads is the whole cycle, so that has to fit
+        const int fits = (int)((capacity - maxBlock - 2) / sliceSamples);
+        blockRepeats = juce::jlimit(1, juce::jmax(1, fits), repeats.load(std::memory_order_relaxed));
+        playingRepeats.store(blockRepeats, std::memory_order_relaxed);
+        blockReverse = reverse.load(std::memory_order_relaxed);
+        const double cycleSamples = sliceSamples * blockRepeats;
+
+        // the host's PPQ when it's playing, our own count when it isn't
+        double start = freePosition;
+        if (position && position->getIsPlaying() && position->getPpqPosition())
+            start = *position->getPpqPosition() * beatSamples - latency;
+        freePosition = start + numSamples;
+
+        cyclePos = std::fmod(start, cycleSamples);
+        if (cyclePos < 0.0)
+            cyclePos += cycleSamples;
+
+        wasActive = true;
+        return true;
+    }
+
+    // audio thread: captures samples [start, start + n) and replaces them with the replay
+    void process(juce::AudioBuffer<float>& buffer, int start, int n, int numChannels)
+    {
+        CHRONOS_TRACE_SCOPE("Stutter::process");
+        jassert(n <= maxBlock);
+        numChannels = juce::jmin(numChannels, ring.getNumChannels(), buffer.getNumChannels());
+
+        const int chunkStart = writePos;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* src = buffer.getReadPointer(ch, start);
+            float* r = ring.getWritePointer(ch);
+            const int first = juce::jmin(n, capacity - writePos);
+            juce::FloatVectorOperations::copy(r + writePos, src, first);
+            juce::FloatVectorOperations::copy(r, src + first, n - first);
+        }
+        writePos = (writePos + n) % capacity;
+
+        const double cycleSamples = sliceSamples * blockRepeats;
+        for (int i = 0; i < n;)
+        {
+            // one slice (or what's left of it in this chunk) at a time
+            const int slice = juce::jmin(blockRepeats - 1, (int)(cyclePos / sliceSamples));
+            const double offset = cyclePos - slice * sliceSamples;
+            const int len = juce::jlimit(1, n - i, (int)std::ceil(sliceSamples - offset));
+
+            for (int k = 0; k < len; ++k)
+            {
+                const double o = offset + k;
+                slicePhase[(size_t)(i + k)] = juce::jlimit(0.0, 1.0, o / sliceSamples);
+                fade[(size_t)(i + k)] = (float)juce::jlimit(0.0, 1.0, juce::jmin(o, sliceSamples - o) * fadeRate);
+            }
+
+            if (slice > 0)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    float* dest = buffer.getWritePointer(ch, start + i);
+                    if (blockReverse)
+                        readReversed(ch, dest, chunkStart + i, len, slice, offset);
+                    else
+                        readForward(ch, dest, chunkStart + i - (int)std::lround(slice * sliceSamples), len);
+                }
+            }
+
+            cyclePos += len;
+            if (cyclePos >= cycleSamples)
+                cyclePos -= cycleSamples;
+            i += len;
+        }
+
+        if (blockRepeats > 1)
+            for (int ch = 0; ch < numChannels; ++ch)
+                juce::FloatVectorOperations::multiply(buffer.getWritePointer(ch, start), fade.data(), n);
+    }
+
+    // audio thread: the drawn curve across each slice of the last process call, 0..1
+    void renderEnvelope(LFO& lfo, float* dest, int n)
+    {
+        lfo.renderAt(dest, slicePhase.data(), n);
+        juce::FloatVectorOperations::clip(dest, dest, 0.0f, 1.0f, n);
+
+        if (blockMode == Mode::Gate)
+            for (int i = 0; i < n; ++i)
+                dest[i] = dest[i] >= 0.5f ? 1.0f : 0.0f;
+    }
+
+private:
+    double sampleRate = 44100.0;
+    int maxBlock = 512;
+    int capacity = 0;
+    juce::AudioBuffer<float> ring;
+    std::vector<double> slicePhase = std::vector<double>(512, 0.0);
+    std::vector<float> fade = std::vector<float>(512, 1.0f);
+    double fadeRate = 0.0;
+
+    // audio thread
+    int writePos = 0;
+    double freePosition = 0.0;
+    double cyclePos = 0.0, sliceSamples = 1.0;
+    int blockRepeats = 1;
+    bool blockReverse = false;
+    Mode blockMode = Mode::Off;
+    bool wasActive = false;
+
+    int wrap(int index) const { return ((index % capacity) + capacity) % capacity; }
+
+    void readForward(int ch, float* dest, int from, int len) const
+    {
+        const float* r = ring.getReadPointer(ch);
+        from = wrap(from);
+        const int first = juce::jmin(len, capacity - from);
+        juce::FloatVectorOperations::copy(dest, r + from, first);
+        juce::FloatVectorOperations::copy(dest + first, r, len - first);
+    }
+
+    // slice sample at 'offset' plays the captured one at (length - 1 - offset)
+    void readReversed(int ch, float* dest, int now, int len, int slice, double offset) const
+    {
+        const float* r = ring.getReadPointer(ch);
+        const int sliceStart = now - (int)std::lround(slice * sliceSamples + offset);
+        int index = wrap(sliceStart + (int)sliceSamples - 1 - (int)offset);
+        for (int k = 0; k < len; ++k)
+        {
+            dest[k] = r[index];
+            index = index > 0 ? index - 1 : capacity - 1;
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Stutter)
+};
@@ -0,0 +1,106 @@
+// StutterPanel.h
+#pragma once
+#include <JuceHeader.h>
+#include "Stutter.h"
+
+// Mode, slice length, repeats and reverse for the processor's Stutter. Writes straight into
+// its atomics; refresh() pulls them back after a state load. While it's showing, a slow timer
+// says so in the hint when the tempo is too slow for the whole cycle and the repeats get cut.
+class StutterPanel : public juce::Component, private juce::Timer
+{
+public:
+    explicit StutterPanel(Stutter& stutterToEdit) : stutter(stutterToEdit)
+    {
+        mode.addItemList({ "Stutter off", "Stutter: gate", "Stutter: envelope" }, 1);
+        mode.onChange = [this]() { stutter.mode = mode.getSelectedId() - 1; };
+        addAndMakeVisible(mode);
+
+        // ids are the note denominators
+        for (int denominator : { 16, 8, 4, 2, 1 })
+            slice.addItem("1/" + juce::String(denominator), denominator);
+        slice.onChange = [this]() { stutter.sliceDenominator = slice.getSelectedId(); };
+        addAndMakeVisible(slice);
+
+        for (int count : { 2, 3, 4, 6, 8, 16 })
+            repeats.addItem("x" + juce::String(count), count);
+        repeats.onChange = [this]() { stutter.repeats = repeats.getSelectedId(); };
+        addAndMakeVisible(repeats);
+
+        reverse.setColour(juce::ToggleButton::textColourId, juce::Colours::white);
+        reverse.setColour(juce::ToggleButton::tickColourId, juce::Colour(35, 247, 176));
+        reverse.onClick = [this]() { stutter.reverse = reverse.getToggleState(); };
+        addAndMakeVisible(reverse);
+
+        hint.setText(hintText, juce::dontSendNotification);
+        hint.setFont(juce::Font(12.0f));
+        hint.setColour(juce::Label::textColourId, juce::Colours::grey);
+        hint.setJustificationType(juce::Justification::topLeft);
+        addAndMakeVisible(hint);
+
+        refresh();
+    }
+
+    void refresh()
+    {
+        mode.setSelectedId(juce::jlimit(0, 2, stutter.mode.load()) + 1, juce::dontSendNotification);
+        slice.setSelectedId(stutter.sliceDenominator.load(), juce::dontSendNotification);
+        repeats.setSelectedId(stutter.repeats.load(), juce::dontSendNotification);
+        reverse.setToggleState(stutter.reverse.load(), juce::dontSendNotification);
+    }
+
+    void visibilityChanged() override
+    {
+        if (isVisible())
+            startTimerHz(4);
+        else
+            stopTimer();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.setColour(juce::Colour(30, 30, 34));
+        g.fillRoundedRectangle(getLocalBounds().toFloat(), 4.0f);
+    }
+
+    void resized() override
+    {
+        auto r = getLocalBounds().reduced(6);
+        mode.setBounds(r.removeFromTop(24));
+        r.removeFromTop(6);
+
+        auto row = r.removeFromTop(24);
+        slice.setBounds(row.removeFromLeft(70));
+        row.removeFromLeft(6);
+        repeats.setBounds(row.removeFromLeft(60));
+        row.removeFromLeft(6);
+        reverse.setBounds(row);
+
+        r.removeFromTop(8);
+        hint.setBounds(r);
+    }
+
+private:
+    Stutter& stutter;
+
+    static constexpr const char* hintText = "Slices start on the host grid. The first plays live, the repeats replay it, "
+                                            "shaped by the drawn curve (gate: on above half).";
+
+    void timerCallback() override
+    {
+        const int playing = stutter.playingRepeats.load();
+        const int asked = stutter.repeats.load();
+        const juce::String text = playing > 0 && playing < asked
+            ? "x" + juce::String(asked) + " is cut to x" + juce::String(playing) + " at this tempo: the buffer holds "
+              + juce::String((int)Stutter::ringBeats) + " beats at " + juce::String((int)Stutter::ringBpm) + " BPM."
+            : juce::String(hintText);
+
+        if (hint.getText() != text)
+            hint.setText(text, juce::dontSendNotification);
+    }
+
+    juce::ComboBox mode, slice, repeats;
+    juce::ToggleButton reverse{ "Reverse" };
+    juce::Label hint;
+
+    JUCE_DECLARE_NON_COPYABLE(StutterPanel)
+};
@@ -0,0 +1,197 @@
+// Trace.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+
+// Scoped trace markers that can be dumped as a Chrome/Perfetto trace (chrome://tracing,
+// ui.perfetto.dev). Build with CHRONOS_ENABLE_TRACING=1 to get them; otherwise every
+// CHRONOS_TRACE_* macro expands to nothing, so the audio thread pays nothing at all.
+//
+// When compiled in, an idle marker is one relaxed atomic load. While recording, each thread
+// writes into its own fixed ring buffer (claimed from a pool made up front, so the audio
+// thread never allocates or locks); the oldest events get overwritten if a ring fills.
+#ifndef CHRONOS_ENABLE_TRACING
+ #define CHRONOS_ENABLE_TRACING 0
+#endif
+
+#if CHRONOS_ENABLE_TRACING
+
+namespace Trace
+{
+    struct Event
+    {
+        const char* name; // must be a string literal
+        juce::int64 start, end; // high resolution ticks
+    };
+
+    class ThreadBuffer
+    {
+    public:
+        static constexpr juce::uint32 capacity = 1 << 15;
+
+        void push(const char* name, juce::int64 start, juce::int64 end)
+        {
+            const auto n = written.load(std::memory_order_relaxed);
+            events[n & (capacity - 1)] = { name, start, end };
+            written.store(n + 1, std::memory_order_release);
+        }
+
+        std::array<Event, capacity> events;
+        std::atomic<juce::uint32> written{ 0 };
+        char threadName[48] = {};
+        int threadIndex = 0;
+    };
+
+    class Registry
+    {
+    public:
+        static Registry& get()
+        {
+            static Registry instance;
+            return instance;
+        }
+
+        bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+
+        // message thread: (re)start recording from empty rings
+        void start()
+        {
+            recording = false;
+            for (auto& b : buffers)
+            {
+                if (b == nullptr)
+                    b = std::make_unique<ThreadBuffer>();
+                b->written = 0;
+            }
+            startTicks = juce::Time::getHighResolutionTicks();
+            recording = true;
+        }
+
+        void stop() { recording = false; }
+
+        // stops recording and writes everything captured as Chrome trace JSON
+        bool stopAndDump(const juce::File& file)
+        {
+            stop();
+            juce::Thread::sleep(5); // let a marker that was mid-write finish
+
+            juce::MemoryOutputStream out;
+            out << "{\"traceEvents\":[\n";
+            bool first = true;
+            const double ticksToUs = 1.0e6 / (double)juce::Time::getHighResolutionTicksPerSecond();
+
+            for (int t = 0; t < juce::jmin(maxThreads, claimed.load()); ++t)
+            {
+                if (buffers[(size_t)t] == nullptr)
+                    continue;
+
+                auto& b = *buffers[(size_t)t];
+                const auto written = b.written.load(std::memory_order_acquire);
+                const auto count = juce::jmin(written, ThreadBuffer::capacity);
+
+                if (!first) out << ",\n";
+                first = false;
+                out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b.threadIndex
+                    << ",\"args\":{\"name\":" << juce::JSON::toString(juce::String::fromUTF8(b.threadName)) << "}}";
+
+                for (auto i = written - count; i != written; ++i)
+                {
+                    auto& e = b.events[i & (ThreadBuffer::capacity - 1)];
+                    out << ",\n{\"name\":" << juce::JSON::toString(juce::String(e.name))
+                        << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << b.threadIndex
+                        << ",\"ts\":" << juce::String((double)(e.start - startTicks) * ticksToUs, 3)
+                        << ",\"dur\":" << juce::String((double)(e.end - e.start) * ticksToUs, 3) << "}";
+                }
+            }
+
+            out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+            return file.replaceWithData(out.getData(), out.getDataSize());
+        }
+
+        // the calling thread's ring, claimed on first use; nullptr if the pool ran out
+        ThreadBuffer* bufferForThisThread()
+        {
+            thread_local ThreadBuffer* mine = nullptr;
+            thread_local bool poolWasFull = false;
+            if (mine != nullptr || poolWasFull)
+                return mine;
+
+            const int index = claimed.fetch_add(1);
+            if (index >= maxThreads || buffers[(size_t)index] == nullptr)
+            {
+                poolWasFull = true;
+                return nullptr;
+            }
+
+            mine = buffers[(size_t)index].get();
+            mine->threadIndex = index + 1;
+            nameThread(*mine);
+            return mine;
+        }
+
+        // label the calling thread (e.g. "audio") if it hasn't got a name yet
+        void setThreadName(const char* name)
+        {
+            if (auto* b = bufferForThisThread())
+                if (b->threadName[0] == 0 || b->threadName[0] == '#')
+                    std::snprintf(b->threadName, sizeof(b->threadName), "%s", name);
+        }
+
+    private:
+        static constexpr int maxThreads = 32;
+
+        std::array<std::unique_ptr<ThreadBuffer>, maxThreads> buffers;
+        std::atomic<int> claimed{ 0 };
+        std::atomic<bool> recording{ false };
+        juce::int64 startTicks = 0;
+
+        // may run on the audio thread, so nothing in here allocates
+        static void nameThread(ThreadBuffer& b)
+        {
+            if (auto* mm = juce::MessageManager::getInstanceWithoutCreating(); mm != nullptr && mm->isThisTheMessageThread())
+                std::snprintf(b.threadName, sizeof(b.threadName), "message thread");
+            else if (auto* t = juce::Thread::getCurrentThread())
+                t->getThreadName().copyToUTF8(b.threadName, sizeof(b.threadName));
+            else
+                std::snprintf(b.threadName, sizeof(b.threadName), "#%d", b.threadIndex);
+        }
+    };
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* eventName)
+            : name(eventName),
+              buffer(Registry::get().isRecording() ? Registry::get().bufferForThisThread() : nullptr),
+              start(buffer != nullptr ? juce::Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~Scope()
+        {
+            if (buffer != nullptr)
+                buffer->push(name, start, juce::Time::getHighResolutionTicks());
+        }
+
+    private:
+        const char* name;
+        ThreadBuffer* buffer;
+        juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+}
+
+ #define CHRONOS_TRACE_SCOPE(name)  const Trace::Scope JUCE_JOIN_MACRO(chronosTrace_, __LINE__)(name)
+ #define CHRONOS_TRACE_THREAD(name) do { if (Trace::Registry::get().isRecording()) Trace::Registry::get().setThreadName(name); } while (false)
+
+#else
+
+ #define CHRONOS_TRACE_SCOPE(name)
+ #define CHRONOS_TRACE_THREAD(name)
+
+#endif
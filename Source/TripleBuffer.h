@@ -0,0 +1,52 @@
+// TripleBuffer.h
+#pragma once
+#include <array>
+#include <atomic>
+
+// Lock-free hand-off of a whole object from one writer thread to the audio thread.
+// The writer fills getWriteBuffer() and calls publish(); the reader calls acquire()
+// and then reads getReadBuffer(). Neither side ever waits or allocates, and the
+// reader always sees a complete object. One writer at a time - serialise writers yourself.
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // writer side
+    T& getWriteBuffer() { return slots[writeIndex]; }
+
+    void publish()
+    {
+        writeIndex = shared.exchange(writeIndex | newFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // reader side - returns true if a newer object was picked up
+    bool acquire()
+    {
+        if ((shared.load(std::memory_order_relaxed) & newFlag) == 0)
+            return false;
+
+        readIndex = shared.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const T& getReadBuffer() const { return slots[readIndex]; }
+
+    // for sizing every slot up front (call before the audio thread starts reading)
+    template <typename Fn>
+    void forEachSlot(Fn&& fn)
+    {
+        for (auto& s : slots)
+            fn(s);
+    }
+
+private:
+    static constexpr int newFlag = 4;
+    static constexpr int indexMask = 3;
+
+    std::array<T, 3> slots{};
+    int writeIndex = 0;
+    int readIndex = 1;
+    std::atomic<int> shared{ 2 };
+};
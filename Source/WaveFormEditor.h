@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <cmath>
 #include "GlowEffect.h"
+#include "Curve.h"
+#include "LFO.h"
 
 
 
@@ -13,8 +15,8 @@ class WaveformEditor : public juce::Component,
 public:
     WaveformEditor()
     {
-        points = { {0.0f, 0.5f}, {0.5f, 1.0f}, {1.0f, 0.5f} };
-        segments.resize(std::max<size_t>(1, points.size() - 1));
+        curve.points = { {0.0f, 0.5f}, {0.5f, 1.0f}, {1.0f, 0.5f} };
+        curve.segments.resize(std::max<size_t>(1, curve.points.size() - 1));
         setOpaque(false); // change this to true if something getts hidden behind the line 
         startTimerHz(30);  
         setWantsKeyboardFocus(true);
@@ -42,13 +44,15 @@ public:
 
     
 
-    using UpdateCallback = std::function<void(const std::vector<float>&)>;
+    // called on every edit with the whole curve; baking is the receiver's business
+    using UpdateCallback = std::function<void(const Curve&)>;
     void setUpdateCallback(UpdateCallback cb) { updateCallback = std::move(cb); }
 
 
 
     void paint(juce::Graphics& g) override
     {
+        CHRONOS_TRACE_SCOPE("WaveformEditor::paint");
         g.fillAll(juce::Colours::black.darker(0.2f));
         g.setColour(juce::Colour(44, 44, 49));
         g.fillRect(getLocalBounds().reduced(6));
@@ -59,9 +63,9 @@ public:
 
         // Build and draw path using quadratic segments (control point from tension)
         juce::Path p;
-        if (points.size() >= 2)
+        if (curve.points.size() >= 2)
         {
-            auto p0 = toPixel(points.front());
+            auto p0 = toPixel(curve.points.front());
             p.startNewSubPath(p0);
 
             const int VIS_SAMPLES = 256;
@@ -78,21 +82,21 @@ public:
         g.strokePath(p, juce::PathStrokeType(2.0f));
 
         // draw control points
-        for (size_t i = 0; i < points.size(); ++i)
+        for (size_t i = 0; i < curve.points.size(); ++i)
         {
-            auto pixel = toPixel(points[i]);
+            auto pixel = toPixel(curve.points[i]);
             g.setColour(juce::Colour(157, 251, 220)); //Control pointsm Light green
             g.fillEllipse(pixel.x - 4.0f, pixel.y - 4.0f, 8.0f, 8.0f);
         }
 
         // draw segment control handles (visualize tension)
-        for (size_t i = 0; i + 1 < points.size(); ++i)
+        for (size_t i = 0; i + 1 < curve.points.size(); ++i)
         {
-            float tension = segments[i].tension;
+            float tension = curve.segments[i].tension;
             if (std::abs(tension) > 0.001f)
             {
-                auto p1 = toPixel(points[i]);
-                auto p2 = toPixel(points[i + 1]);
+                auto p1 = toPixel(curve.points[i]);
+                auto p2 = toPixel(curve.points[i + 1]);
                 juce::Point<float> mid = (p1 + p2) * 0.5f;
                 // visual offset: scale tension to pixels
                 mid.y -= tension * 40.0f;
@@ -102,19 +106,19 @@ public:
         }
 
         // highlighted handle
-        if (selected >= 0 && selected < (int)points.size())
+        if (selected >= 0 && selected < (int)curve.points.size())
         {
-            auto s = toPixel(points[selected]);
+            auto s = toPixel(curve.points[selected]);
             g.setColour(juce::Colour(140, 191, 227));//light blue
             g.drawEllipse(s.x - 6.0f, s.y - 6.0f, 12.0f, 12.0f, 2.0f);
         }
         // highlight selected segment handle
-        if (selectedSegment >= 0 && selectedSegment < (int)segments.size())
+        if (selectedSegment >= 0 && selectedSegment < (int)curve.segments.size())
         {
-            auto p1 = toPixel(points[selectedSegment]);
-            auto p2 = toPixel(points[selectedSegment + 1]);
+            auto p1 = toPixel(curve.points[selectedSegment]);
+            auto p2 = toPixel(curve.points[selectedSegment + 1]);
             juce::Point<float> mid = (p1 + p2) * 0.5f;
-            mid.y -= segments[selectedSegment].tension * 40.0f;
+            mid.y -= curve.segments[selectedSegment].tension * 40.0f;
             g.setColour(juce::Colour(140, 191, 227)); //light blue 
             g.drawEllipse(mid.x - 6.0f, mid.y - 6.0f, 12.0f, 12.0f, 2.0f);
         }
@@ -150,7 +154,7 @@ public:
                 // start dragging a control point
                 selected = idx;
                 auto posPix = toPixel(pos);
-                dragOffset = toPixel(points[idx]) - e.position;; // consistent with JUCE typing
+                dragOffset = toPixel(curve.points[idx]) - e.position;; // consistent with JUCE typing
             }
             else
             {
@@ -161,8 +165,7 @@ public:
                     selected = indexOfPointNear(toPixel(pos), hitRadius);
                     repaint();
                     // immediate update for instant visual/audio feedback
-                    if (updateCallback)
-                        updateCallback(createSampleBuffer(1024, true));
+                    pushUpdate();
                 }
                 else
                 {
@@ -171,7 +174,7 @@ public:
                     {
                         selectedSegment = segIdx;
                         dragStartY = e.position.y;
-                        initialTension = segments[segIdx].tension;
+                        initialTension = curve.segments[segIdx].tension;
                     }
                     else
                     {
@@ -181,7 +184,7 @@ public:
                         {
                             selectedSegment = segIdx;
                             dragStartY = e.position.y;
-                            initialTension = segments[segIdx].tension;
+                            initialTension = curve.segments[segIdx].tension;
                         }
                     }
                 }
@@ -189,15 +192,15 @@ public:
         }
         else if (e.mods.isRightButtonDown())
         {
-            if (idx >= 0 && points.size() > 2) // keep at least 2 points
+            if (idx >= 0 && curve.points.size() > 2) // keep at least 2 points
             {
-                points.erase(points.begin() + idx);
+                curve.points.erase(curve.points.begin() + idx);
                 // keep segments synced
-                segments.resize(std::max<size_t>(1, points.size() - 1));
+                curve.segments.resize(std::max<size_t>(1, curve.points.size() - 1));
                 selected = -1;
                 selectedSegment = -1;
                 repaint();
-                pushUpdate(); // push to audio via timer
+                pushUpdate();
             }
         }
     }
@@ -205,34 +208,34 @@ public:
     void mouseDrag(const juce::MouseEvent& e) override
     {
         // If dragging a point
-        if (selected >= 0 && selected < (int)points.size())  //should update now using pixel data
+        if (selected >= 0 && selected < (int)curve.points.size())  //should update now using pixel data
         {
             auto newPix = e.position + dragOffset;
             auto newNorm = fromPixelExact(newPix);
 
-            float leftBound = (selected == 0) ? 0.0f : points[selected - 1].x + 0.001f;
-            float rightBound = (selected == (int)points.size() - 1) ? 1.0f : points[selected + 1].x - 0.001f;
+            float leftBound = (selected == 0) ? 0.0f : curve.points[selected - 1].x + 0.001f;
+            float rightBound = (selected == (int)curve.points.size() - 1) ? 1.0f : curve.points[selected + 1].x - 0.001f;
 
             newNorm.x = juce::jlimit(leftBound, rightBound, newNorm.x);
             newNorm.y = juce::jlimit(0.0f, 1.0f, newNorm.y);
 
-            points[selected] = newNorm;
+            curve.points[selected] = newNorm;
 
             repaint();
-            pushUpdateDebounced();
+            pushUpdate();
         }
         // Else if dragging a segment's tension handle
-        else if (selectedSegment >= 0 && selectedSegment < (int)segments.size())
+        else if (selectedSegment >= 0 && selectedSegment < (int)curve.segments.size())
         {
             float dy = (dragStartY - e.position.y) / (float)getHeight();
             float newT = juce::jlimit(-1.0f, 1.0f, initialTension + dy * 3.5f); //<----change last number to exxagerate curve: TENSION stardew
-            if (std::abs(newT - segments[selectedSegment].tension) > 1e-4f)
+            if (std::abs(newT - curve.segments[selectedSegment].tension) > 1e-4f)
             {
-                segments[selectedSegment].tension = newT;
+                curve.segments[selectedSegment].tension = newT;
                 // immediate visual feedback
                 repaint();
-                // push update to audio (debounced)
-                pushUpdateDebounced();
+                // push update to audio (the baker coalesces a fast drag)
+                pushUpdate();
             }
         }
     }
@@ -246,50 +249,29 @@ public:
     }
 
     // create sampled buffer (N samples) from current control points (uses quadratic per-segment)
-    std::vector<float> createSampleBuffer(int N = 512, bool smooth = false)
+    std::vector<float> createSampleBuffer(int N = 512, bool smooth = false) const
     {
-        std::vector<float> out;
-        out.resize(N);
-        if (points.empty()) return out;
-        for (int i = 0; i < N; ++i)
-        {
-            float t = (float)i / (float)N;
-            out[i] = sampleFromPoints(t);
-        }
-
-        if (smooth)
-        {
-            // simple smoothing: 3-tap moving average (non destructive, light)
-            std::vector<float> tmp(N);
-            for (int i = 0; i < N; ++i)
-                tmp[i] = (out[(i - 1 + N) % N] + out[i] + out[(i + 1) % N]) / 3.0f;
-            out.swap(tmp);
-        }
-
-        // ensure samples in 0..1
-        for (auto& v : out) v = juce::jlimit(0.0f, 1.0f, v);
-        return out;
+        return curve.createSampleBuffer(N, smooth);
     }
 
 
 
 
     // Change waveforms to common shapes with dropdwon menu 
-    void setPresetWaveform(const std::string& shape)
+    void setPresetWaveform(LFO::Shape shape)
     {
         selected = -1;
         selectedSegment = -1;
-        pendingUpdate = false;
 
 
-        points.clear();
+        curve.points.clear();
 
         const int N = 128; // resolution for curve
-        if (shape == "Sine")
+        if (shape == LFO::Shape::Sine)
         {
-            for (auto& seg : segments) seg.tension = 0.0f; //should reset tension after preset change
+            for (auto& seg : curve.segments) seg.tension = 0.0f; //should reset tension after preset change
 
-            points = {
+            curve.points = {
         {0.0f, 0.5f},   
         {0.25f, 1.0f},  
         {0.5f, 0.5f},   
@@ -298,36 +280,35 @@ public:
             };
 
             // Should add curvature to the sin 
-            segments.resize(points.size() - 1);
-            for (size_t i = 0; i < segments.size(); ++i)
+            curve.segments.resize(curve.points.size() - 1);
+            for (size_t i = 0; i < curve.segments.size(); ++i)
             {
-                segments[i].tension = (i < 2) ? 0.5f : -0.5f;   // positive curve on first half, negative on second
+                curve.segments[i].tension = (i < 2) ? 0.5f : -0.5f;   // positive curve on first half, negative on second
             } 
         }
-        else if (shape == "Saw")
+        else if (shape == LFO::Shape::Saw)
         {
-            points = { {0.0f, 0.0f} ,{0.03f, 1.0f}, {1.0f, 0.0f} };
+            curve.points = { {0.0f, 0.0f} ,{0.03f, 1.0f}, {1.0f, 0.0f} };
         }
-        else if (shape == "Triangle")
+        else if (shape == LFO::Shape::Triangle)
         {
-            points = { {0.0f, 0.0f}, {0.5f, 1.0f}, {1.0f, 0.0f} };
+            curve.points = { {0.0f, 0.0f}, {0.5f, 1.0f}, {1.0f, 0.0f} };
         }
-        else if (shape == "Square")
+        else if (shape == LFO::Shape::Square)
         {
-            points = { {0.0f, 1.0f}, {0.5f, 1.0f}, {0.5f, 0.0f}, {1.0f, 0.0f} };
+            curve.points = { {0.0f, 1.0f}, {0.5f, 1.0f}, {0.5f, 0.0f}, {1.0f, 0.0f} };
         }
 
-        segments.resize(std::max<size_t>(1, points.size() - 1));
+        curve.segments.resize(std::max<size_t>(1, curve.points.size() - 1));
 
-        if (shape != "Sine") {
-            for (auto& seg : segments) seg.tension = 0.0f; //should reset tension after preset change
+        if (shape != LFO::Shape::Sine) {
+            for (auto& seg : curve.segments) seg.tension = 0.0f; //should reset tension after preset change
         }
 
         repaint();
 
         // Sends immediate update to the LFO
-        if (updateCallback)
-            updateCallback(createSampleBuffer(1024, true));
+        pushUpdate();
     }
 
 
@@ -335,14 +316,24 @@ public:
         animationSpeed = hz;
     }
 
+    const Curve& getCurve() const { return curve; }
+
+    // load a curve (e.g. restored from the processor) without pushing it back to the audio side
+    void setCurve(const Curve& newCurve)
+    {
+        selected = -1;
+        selectedSegment = -1;
+
+        curve = newCurve;
+        curve.syncSegments();
+        repaint();
+    }
+
 
     //==========================================================================================================
 private:
-    struct P { float x, y; };
-    std::vector<P> points;
-
-    struct Segment { float tension = 0.0f; };
-    std::vector<Segment> segments;
+    using P = Curve::Point;
+    Curve curve;
 
     int selected = -1;
     juce::Point<float> dragOffset{ 0.0f,0.0f }; //point typing 
@@ -354,7 +345,6 @@ private:
     float initialTension = 0.0f;
 
     UpdateCallback updateCallback;
-    bool pendingUpdate = false;
 
 
     //for dot animation along line
@@ -395,9 +385,9 @@ private:
     // hit test for points
     int indexOfPointNear(juce::Point<float> pixelPos, float tol) const
     {
-        for (size_t i = 0; i < points.size(); ++i)
+        for (size_t i = 0; i < curve.points.size(); ++i)
         {
-            auto pPix = toPixel(points[i]);
+            auto pPix = toPixel(curve.points[i]);
             if (pPix.getDistanceFrom(pixelPos) < tol)
                 return (int)i;
         }
@@ -407,11 +397,11 @@ private:
     // improved hit test for segments: distance from normalized point to normalized line segment
     int indexOfSegmentNear(const P& p, float tol) const
     {
-        if (points.size() < 2) return -1;
-        for (size_t i = 0; i + 1 < points.size(); ++i)
+        if (curve.points.size() < 2) return -1;
+        for (size_t i = 0; i + 1 < curve.points.size(); ++i)
         {
-            P a = points[i];
-            P b = points[i + 1];
+            P a = curve.points[i];
+            P b = curve.points[i + 1];
             // project p onto segment ab in normalized coordinates
             float vx = b.x - a.x;
             float vy = b.y - a.y;
@@ -432,13 +422,13 @@ private:
 
     int indexOfTensionHandleNear(juce::Point<float> pixelPos, float tol) const  //for attatching edits to orange points 
     {
-        if (points.size() < 2) return -1;
-        for (size_t i = 0; i + 1 < points.size(); ++i)
+        if (curve.points.size() < 2) return -1;
+        for (size_t i = 0; i + 1 < curve.points.size(); ++i)
         {
-            auto p1 = toPixel(points[i]);
-            auto p2 = toPixel(points[i + 1]);
+            auto p1 = toPixel(curve.points[i]);
+            auto p2 = toPixel(curve.points[i + 1]);
             juce::Point<float> mid = (p1 + p2) * 0.5f;
-            mid.y -= segments[i].tension * 40.0f; 
+            mid.y -= curve.segments[i].tension * 40.0f; 
 
             if (mid.getDistanceFrom(pixelPos) < tol)
                 return (int)i;
@@ -451,39 +441,12 @@ private:
     // add point and keep segments synced
     void addPointConstrained(const P& p)
     {
-        points.push_back(p);
-        std::sort(points.begin(), points.end(), [](const P& a, const P& b) { return a.x < b.x; });
-        segments.resize(std::max<size_t>(1, points.size() - 1));
+        curve.points.push_back(p);
+        std::sort(curve.points.begin(), curve.points.end(), [](const P& a, const P& b) { return a.x < b.x; });
+        curve.segments.resize(std::max<size_t>(1, curve.points.size() - 1));
     }
 
-    // sample using quadratic bezier per segment using tension -> control point
-    float sampleFromPoints(float t) const
-    {
-        if (points.empty()) return 0.5f;
-        if (t <= points.front().x) return points.front().y;
-        if (t >= points.back().x) return points.back().y;
-
-        for (size_t i = 0; i + 1 < points.size(); ++i)
-        {
-            if (t >= points[i].x && t <= points[i + 1].x)
-            {
-                float segT = (t - points[i].x) / (points[i + 1].x - points[i].x);
-                float y1 = points[i].y;
-                float y2 = points[i + 1].y;
-                float tension = (i < segments.size()) ? segments[i].tension : 0.0f;
-
-                // controlY near midpoint adjusted by tension
-                //float controlY = juce::jlimit(0.0f, 1.0f, 0.5f * (y1 + y2) + tension * 0.25f);
-                float controlY = juce::jlimit(0.0f, 1.0f, 0.5f * (y1 + y2) + tension * 0.5f);  //<------change first number for change in tension stardew 
-
-
-                float inv = 1.0f - segT;
-                float y = inv * inv * y1 + 2.0f * inv * segT * controlY + segT * segT * y2;
-                return y;
-            }
-        }
-        return points.back().y;
-    }
+    float sampleFromPoints(float t) const { return curve.sample(t); }
 
     void drawGrid(juce::Graphics& g, juce::Rectangle<int> area)
     {
@@ -500,23 +463,13 @@ private:
     // update push helpers
     void pushUpdate()
     {
-        pendingUpdate = true;
-    }
-
-    void pushUpdateDebounced()
-    {
-        pushUpdate();
+        if (updateCallback)
+            updateCallback(curve);
     }
 
     void timerCallback() override
     {
-        if (pendingUpdate && updateCallback)
-        {
-            pendingUpdate = false;
-            auto buf = createSampleBuffer(1024, true);
-            updateCallback(buf);
-        }
-
+        CHRONOS_TRACE_SCOPE("WaveformEditor::timerCallback");
 
         const float dt = 1.0f / 30.0f;  // timer is at 30 Hz
         animationPhase = std::fmod(animationPhase + animationSpeed * dt, 1.0f);
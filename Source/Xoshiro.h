@@ -0,0 +1,91 @@
+// Xoshiro.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cstdint>
+
+// Random floats for the audio thread: four xoshiro128+ generators side by side (one state
+// word per lane in each array, so the refill loop vectorises), drawn 16 at a time into a
+// batch that next() hands out. Seeding goes through splitmix64, so any 64-bit seed is fine
+// and the same seed always gives the same sequence. No std::rand, no <random>, no locks.
+class Xoshiro
+{
+public:
+    static constexpr int lanes = 4;
+    static constexpr int batchSize = 16;
+
+    Xoshiro() { seed(1); }
+
+    void seed(std::uint64_t value)
+    {
+        std::uint64_t x = value;
+        for (auto& word : state)
+            for (auto& lane : word)
+                lane = (std::uint32_t)(splitMix(x) >> 32);
+
+        // all-zero is the one state xoshiro can't leave
+        for (int lane = 0; lane < lanes; ++lane)
+            if ((state[0][(size_t)lane] | state[1][(size_t)lane] | state[2][(size_t)lane] | state[3][(size_t)lane]) == 0)
+                state[0][(size_t)lane] = 0x9e3779b9u;
+
+        position = batchSize; // refill on the next draw
+    }
+
+    // 0..1 (never 1)
+    float next()
+    {
+        if (position == batchSize)
+            refill();
+        return batch[(size_t)position++];
+    }
+
+    // a seed for "this seed at this point of the song", e.g. a cycle index from the host PPQ
+    static std::uint64_t combine(std::uint64_t seed, std::int64_t index)
+    {
+        std::uint64_t x = seed * 0x9e3779b97f4a7c15ull ^ (std::uint64_t)index;
+        return splitMix(x);
+    }
+
+private:
+    std::array<std::array<std::uint32_t, lanes>, 4> state{};
+    std::array<float, batchSize> batch{};
+    int position = batchSize;
+
+    static std::uint64_t splitMix(std::uint64_t& x)
+    {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    void refill()
+    {
+        auto& s0 = state[0];
+        auto& s1 = state[1];
+        auto& s2 = state[2];
+        auto& s3 = state[3];
+
+        for (int draw = 0; draw < batchSize / lanes; ++draw)
+        {
+            for (size_t lane = 0; lane < (size_t)lanes; ++lane)
+            {
+                const std::uint32_t result = s0[lane] + s3[lane];
+                const std::uint32_t t = s1[lane] << 9;
+
+                s2[lane] ^= s0[lane];
+                s3[lane] ^= s1[lane];
+                s1[lane] ^= s2[lane];
+                s0[lane] ^= s3[lane];
+                s2[lane] ^= t;
+                s3[lane] = (s3[lane] << 11) | (s3[lane] >> 21);
+
+                // top 24 bits (the low ones of xoshiro+ are weak) -> [0, 1)
+                batch[(size_t)draw * lanes + lane] = (float)(result >> 8) * (1.0f / 16777216.0f);
+            }
+        }
+        position = 0;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Xoshiro)
+};
@@ -0,0 +1,47 @@
+// AllocationHooks.cpp
+#include "AllocationHooks.h"
+#include "RealtimeGuard.h"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    thread_local bool watching = false;
+    thread_local int64_t allocations = 0;
+
+    void* allocate(std::size_t size)
+    {
+        if (watching)
+            ++allocations;
+
+        RealtimeGuard::report("operator new");
+
+        if (auto* p = std::malloc(size == 0 ? 1 : size))
+            return p;
+
+        throw std::bad_alloc();
+    }
+}
+
+void AllocationHooks::beginWatchingThisThread()
+{
+    allocations = 0;
+    watching = true;
+}
+
+int64_t AllocationHooks::endWatchingThisThread()
+{
+    watching = false;
+    return allocations;
+}
+
+//==============================================================================
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { try { return allocate(size); } catch (...) { return nullptr; } }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { try { return allocate(size); } catch (...) { return nullptr; } }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
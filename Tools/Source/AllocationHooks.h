@@ -0,0 +1,12 @@
+// AllocationHooks.h
+#pragma once
+#include <cstdint>
+
+// Counts operator new calls made by the current thread while it's being watched.
+// The global new/delete replacements live in AllocationHooks.cpp, so this only works
+// in the tools build - the plugin itself never links them.
+namespace AllocationHooks
+{
+    void beginWatchingThisThread();
+    int64_t endWatchingThisThread(); // returns allocations since begin
+}
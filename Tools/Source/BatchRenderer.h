@@ -0,0 +1,185 @@
+// BatchRenderer.h
+#pragma once
+#include <JuceHeader.h>
+#include <iostream>
+#include "ToolUtils.h"
+
+// Offline renderer: runs a fresh processor over each input file on a thread pool.
+// Audio is streamed reader -> processBlock -> writer in fixed-size chunks, so memory per
+// job is one chunk no matter how long the file is. Every file starts from the same state
+// (same settings, transport at bar 1, tables copied in synchronously), so output only
+// depends on the input and the options.
+class BatchRenderer
+{
+public:
+    struct Options
+    {
+        juce::StringArray inputs;
+        juce::File outputDir;            // default: next to each input
+        juce::String suffix = ".chronos";
+        int numThreads = juce::jmax(1, juce::SystemStats::getNumCpus());
+        int chunkSize = 4096;
+
+        double bpm = 120.0;
+        juce::String preset;             // bank preset name or index, optional
+
+        // anything set here overrides the preset (or the defaults without one)
+        juce::Optional<LFO2AudioProcessor::RateMode> mode;
+        juce::Optional<float> division;  // beats per LFO cycle
+        juce::Optional<float> hz;
+        juce::Optional<float> mix;
+
+        int bitDepth = 24;
+    };
+
+    // returns the process exit code
+    static int run(const Options& options)
+    {
+        if (options.inputs.isEmpty())
+        {
+            std::cerr << "nothing to render" << std::endl;
+            return 1;
+        }
+
+        std::atomic<int> failures{ 0 };
+        juce::ThreadPool pool(juce::ThreadPoolOptions{}.withNumberOfThreadsToUse(options.numThreads));
+
+        for (auto& path : options.inputs)
+            pool.addJob([&options, &failures, path]
+            {
+                juce::String error;
+                auto input = juce::File::getCurrentWorkingDirectory().getChildFile(path);
+                auto output = outputFileFor(input, options);
+
+                if (renderFile(input, output, options, error))
+                {
+                    std::cout << "ok   " << input.getFileName() << " -> " << output.getFullPathName() << std::endl;
+                }
+                else
+                {
+                    ++failures;
+                    std::cerr << "FAIL " << input.getFullPathName() << ": " << error << std::endl;
+                }
+            });
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(20);
+
+        std::cout << options.inputs.size() - failures.load() << " rendered, " << failures.load() << " failed" << std::endl;
+        return failures.load() == 0 ? 0 : 1;
+    }
+
+private:
+    static bool fail(juce::String& error, const juce::String& message)
+    {
+        error = message;
+        return false;
+    }
+
+    static juce::File outputFileFor(const juce::File& input, const Options& options)
+    {
+        auto dir = options.outputDir != juce::File() ? options.outputDir : input.getParentDirectory();
+        return dir.getChildFile(input.getFileNameWithoutExtension() + options.suffix + ".wav");
+    }
+
+    static bool renderFile(const juce::File& input, const juce::File& output, const Options& options, juce::String& error)
+    {
+        // per job: format objects aren't shared between threads
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(input));
+        if (reader == nullptr)
+            return fail(error, "can't read it");
+
+        const int numChannels = (int)reader->numChannels;
+        const double sampleRate = reader->sampleRate;
+        if (numChannels < 1 || numChannels > 2)
+            return fail(error, "only mono and stereo files are supported");
+        if (sampleRate <= 0.0)
+            return fail(error, "bad sample rate");
+
+        LFO2AudioProcessor processor;
+        ToolUtils::SyntheticPlayHead playHead;
+        playHead.bpm = options.bpm;
+        playHead.sampleRate = sampleRate;
+
+        if (!ToolUtils::setChannels(processor, numChannels))
+            return fail(error, "processor refused the channel layout");
+
+        if (!applySettings(processor, options, error))
+            return false;
+
+        processor.setPlayHead(&playHead);
+        processor.setNonRealtime(true);
+        processor.setRateAndBufferSizeDetails(sampleRate, options.chunkSize);
+        processor.prepareToPlay(sampleRate, options.chunkSize);
+
+        if (!output.getParentDirectory().createDirectory())
+            return fail(error, "can't create " + output.getParentDirectory().getFullPathName());
+
+        juce::TemporaryFile temp(output);
+        {
+            std::unique_ptr<juce::OutputStream> stream(temp.getFile().createOutputStream());
+            if (stream == nullptr)
+                return fail(error, "can't write " + temp.getFile().getFullPathName());
+
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::AudioFormatWriter> writer(
+                wav.createWriterFor(stream.get(), sampleRate, (unsigned int)numChannels, options.bitDepth, {}, 0));
+            if (writer == nullptr)
+                return fail(error, "can't create a wav writer");
+            stream.release(); // the writer owns it now
+
+            juce::AudioBuffer<float> buffer(numChannels, options.chunkSize);
+            juce::MidiBuffer midi;
+
+            for (juce::int64 pos = 0; pos < reader->lengthInSamples; pos += options.chunkSize)
+            {
+                const int n = (int)juce::jmin<juce::int64>(options.chunkSize, reader->lengthInSamples - pos);
+                juce::AudioBuffer<float> chunk(buffer.getArrayOfWritePointers(), numChannels, n);
+
+                reader->read(&chunk, 0, n, pos, true, numChannels > 1);
+                processor.processBlock(chunk, midi);
+                playHead.advance(n);
+
+                if (!writer->writeFromAudioSampleBuffer(chunk, 0, n))
+                    return fail(error, "write failed");
+            }
+        }
+
+        processor.releaseResources();
+        processor.setPlayHead(nullptr);
+
+        if (!temp.overwriteTargetFileWithTemporary())
+            return fail(error, "can't replace " + output.getFullPathName());
+
+        return true;
+    }
+
+    static bool applySettings(LFO2AudioProcessor& processor, const Options& options, juce::String& error)
+    {
+        PresetBank::Settings base; // processor defaults: BPM, one cycle per beat, full mix
+
+        if (options.preset.isNotEmpty())
+        {
+            // by index, or by (case-insensitive) name
+            auto& bank = processor.getPresetBank();
+            int index = options.preset.containsOnly("0123456789") ? options.preset.getIntValue() : -1;
+            for (int i = 0; index < 0 && i < bank.size(); ++i)
+                if (bank.getName(i).equalsIgnoreCase(options.preset))
+                    index = i;
+
+            if (!juce::isPositiveAndBelow(index, bank.size()) || !bank.getSettings(index, base))
+                return fail(error, "no preset '" + options.preset + "' in " + PresetBank::getDefaultFile().getFullPathName());
+
+            processor.loadPreset(index); // copies the baked table in synchronously
+        }
+
+        processor.mix = juce::jlimit(0.0f, 1.0f, options.mix.orFallback(base.mix));
+        processor.requestRateState(options.mode.orFallback((LFO2AudioProcessor::RateMode)base.mode),
+                                   options.division.orFallback(base.division),
+                                   options.hz.orFallback(base.hz));
+        return true;
+    }
+};
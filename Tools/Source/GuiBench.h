@@ -0,0 +1,291 @@
+// GuiBench.h
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <map>
+#include <iostream>
+#include "ToolUtils.h"
+#include "../../Source/PluginEditor.h"
+
+// Paints the real editor into an offscreen software image, no window or message loop, so
+// GUI cost is a number that can be tracked like the processBlock bench. Two parts:
+//  - whole editor frames at several sizes and scale factors, split into the editor's own
+//    chrome, the curve editor, glowing components, knobs/sliders and everything else
+//  - point drags on a WaveformEditor holding 3, 100 and 2000 points: handler time (hit
+//    test, clamping, the edit callback) and the repaint that follows, per mouse move
+class GuiBench
+{
+public:
+    struct Options
+    {
+        bool quick = false;
+        int frames = 120;             // frames (or drag steps) per configuration
+        juce::File output;            // baseline to write (optional)
+        juce::File compareTo;         // baseline to compare against (optional)
+        double regressionThreshold = 0.15;
+    };
+
+    struct Result
+    {
+        juce::String key;             // e.g. "editor/900x600@2/knobs"
+        double meanUs = 0.0, p99Us = 0.0;
+    };
+
+    // returns the process exit code
+    static int run(const Options& options)
+    {
+        std::vector<juce::Point<int>> sizes{ { 600, 400 }, { 900, 600 }, { 1350, 900 } };
+        std::vector<float> scales{ 1.0f, 2.0f };
+        std::vector<int> pointCounts{ 3, 100, 2000 };
+
+        if (options.quick)
+        {
+            sizes = { { 900, 600 } };
+            scales = { 1.0f };
+        }
+
+        std::vector<Result> results;
+        auto add = [&results](std::vector<Result> more)
+        {
+            for (auto& r : more)
+                print(r);
+            results.insert(results.end(), more.begin(), more.end());
+        };
+
+        for (auto size : sizes)
+            for (auto scale : scales)
+                add(runEditorFrames(size, scale, options.frames));
+
+        for (auto n : pointCounts)
+            add(runCurveDrag(n, options.frames));
+
+        if (options.output != juce::File())
+        {
+            if (!writeBaseline(results, options.output))
+            {
+                std::cerr << "couldn't write " << options.output.getFullPathName() << std::endl;
+                return 1;
+            }
+            std::cout << "baseline written to " << options.output.getFullPathName() << std::endl;
+        }
+
+        if (options.compareTo != juce::File())
+            return compare(results, options.compareTo, options.regressionThreshold) ? 0 : 1;
+
+        return 0;
+    }
+
+private:
+    // a painter that times whatever it's given into one image, reusing it between frames
+    struct Canvas
+    {
+        Canvas(juce::Point<int> size, float s)
+            : image(juce::Image::ARGB, juce::roundToInt((float)size.x * s), juce::roundToInt((float)size.y * s), true,
+                    juce::SoftwareImageType()),
+              scale(s)
+        {
+        }
+
+        // paints c (and its children, unless ownPaintOnly) at origin; returns microseconds
+        double time(juce::Component& c, juce::Point<int> origin, bool ownPaintOnly = false)
+        {
+            image.clear(image.getBounds());
+            juce::Graphics g(image);
+            g.addTransform(juce::AffineTransform::scale(scale));
+            g.setOrigin(origin);
+            g.reduceClipRegion(c.getLocalBounds());
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            if (ownPaintOnly)
+                c.paint(g);
+            else
+                c.paintEntireComponent(g, true);
+            return ToolUtils::ticksToNs(juce::Time::getHighResolutionTicks() - start) / 1000.0;
+        }
+
+        juce::Image image;
+        float scale;
+    };
+
+    // where a direct child of the editor shows up in the breakdown
+    static juce::String categoryOf(juce::Component& child)
+    {
+        if (dynamic_cast<WaveformEditor*>(&child) != nullptr) return "curve";
+        if (child.getComponentEffect() != nullptr)            return "glows";
+        if (dynamic_cast<juce::Slider*>(&child) != nullptr)   return "knobs";
+        return "controls";
+    }
+
+    static std::vector<Result> runEditorFrames(juce::Point<int> size, float scale, int frames)
+    {
+        LFO2AudioProcessor processor;
+        LFO2AudioProcessorEditor editor(processor);
+        editor.setSize(size.x, size.y);
+
+        Canvas canvas(size, scale);
+        std::map<juce::String, std::vector<double>> timings; // category -> per-frame us
+
+        for (int frame = -8; frame < frames; ++frame) // the first few fill glyph/image caches
+        {
+            const double whole = canvas.time(editor, {});
+            const double chrome = canvas.time(editor, {}, true);
+
+            std::map<juce::String, double> perCategory;
+            for (auto* child : editor.getChildren())
+                if (child->isVisible())
+                    perCategory[categoryOf(*child)] += canvas.time(*child, child->getPosition());
+
+            if (frame < 0)
+                continue;
+
+            timings["frame"].push_back(whole);
+            timings["chrome"].push_back(chrome);
+            for (auto& [category, us] : perCategory)
+                timings[category].push_back(us);
+        }
+
+        const auto prefix = "editor/" + juce::String(size.x) + "x" + juce::String(size.y) + "@" + juce::String(scale, 1) + "/";
+        std::vector<Result> results;
+        for (auto& [category, us] : timings)
+            results.push_back(summarise(prefix + category, us));
+        return results;
+    }
+
+    static Curve makeCurve(int numPoints)
+    {
+        Curve curve;
+        for (int i = 0; i < numPoints; ++i)
+        {
+            const float x = (float)i / (float)(numPoints - 1);
+            curve.points.push_back({ x, 0.5f + 0.4f * std::sin(x * juce::MathConstants<float>::twoPi * 3.0f) });
+        }
+        curve.syncSegments();
+        return curve;
+    }
+
+    static juce::MouseEvent mouseEvent(juce::Component& c, juce::Point<float> pos, juce::Point<float> downPos, bool dragged)
+    {
+        const auto now = juce::Time::getCurrentTime();
+        return juce::MouseEvent(juce::Desktop::getInstance().getMainMouseSource(), pos,
+                 juce::ModifierKeys(juce::ModifierKeys::leftButtonModifier),
+                 juce::MouseInputSource::defaultPressure, juce::MouseInputSource::defaultOrientation,
+                 juce::MouseInputSource::defaultRotation, juce::MouseInputSource::defaultTiltX,
+                 juce::MouseInputSource::defaultTiltY, &c, &c, now, downPos, now, 1, dragged);
+    }
+
+    // drag the middle point round in a small circle, repainting after every move like the
+    // message thread would; edits go to a processor so the edit callback does its real work
+    static std::vector<Result> runCurveDrag(int numPoints, int steps)
+    {
+        LFO2AudioProcessor processor;
+        WaveformEditor curveEditor;
+        curveEditor.setSize(600, 300);
+        curveEditor.setCurve(makeCurve(numPoints));
+        curveEditor.setUpdateCallback([&processor](const Curve& edited) { processor.curveEdited(edited, false); });
+
+        // same mapping as WaveformEditor::toPixel
+        const auto& point = curveEditor.getCurve().points[(size_t)numPoints / 2];
+        const auto area = curveEditor.getLocalBounds().toFloat().reduced(10.0f);
+        const juce::Point<float> down{ area.getX() + point.x * area.getWidth(), area.getY() + (1.0f - point.y) * area.getHeight() };
+
+        Canvas canvas({ 600, 300 }, 1.0f);
+        std::vector<double> handler, paint;
+
+        curveEditor.mouseDown(mouseEvent(curveEditor, down, down, false));
+        for (int i = 0; i < steps; ++i)
+        {
+            const float angle = (float)i * 0.2f;
+            const auto pos = down + juce::Point<float>(std::cos(angle) * 20.0f, std::sin(angle) * 40.0f);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            curveEditor.mouseDrag(mouseEvent(curveEditor, pos, down, true));
+            handler.push_back(ToolUtils::ticksToNs(juce::Time::getHighResolutionTicks() - start) / 1000.0);
+
+            paint.push_back(canvas.time(curveEditor, {}));
+        }
+        curveEditor.mouseUp(mouseEvent(curveEditor, down, down, true));
+
+        const auto prefix = "drag/" + juce::String(numPoints) + "pts/";
+        return { summarise(prefix + "handler", handler), summarise(prefix + "paint", paint) };
+    }
+
+    static Result summarise(const juce::String& key, std::vector<double> us)
+    {
+        Result r;
+        r.key = key;
+        if (us.empty())
+            return r;
+
+        double total = 0.0;
+        for (auto v : us)
+            total += v;
+        r.meanUs = total / (double)us.size();
+
+        std::sort(us.begin(), us.end());
+        r.p99Us = ToolUtils::percentile(us, 0.99);
+        return r;
+    }
+
+    static void print(const Result& r)
+    {
+        std::cout << r.key.paddedRight(' ', 36)
+                  << juce::String(r.meanUs, 1).paddedLeft(' ', 10) << " us"
+                  << "   p99 " << juce::String(r.p99Us, 1) << "us" << std::endl;
+    }
+
+    static bool writeBaseline(const std::vector<Result>& results, const juce::File& file)
+    {
+        juce::Array<juce::var> list;
+        for (auto& r : results)
+        {
+            auto* o = new juce::DynamicObject();
+            o->setProperty("key", r.key);
+            o->setProperty("meanUs", r.meanUs);
+            o->setProperty("p99Us", r.p99Us);
+            list.add(juce::var(o));
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("tool", "chronos-guibench");
+        root->setProperty("version", 1);
+        root->setProperty("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty("results", list);
+
+        return file.replaceWithText(juce::JSON::toString(juce::var(root)));
+    }
+
+    // mean time per key against the baseline; anything under 20us is too noisy to judge
+    static bool compare(const std::vector<Result>& results, const juce::File& file, double threshold)
+    {
+        auto baseline = juce::JSON::parse(file);
+        auto* old = baseline["results"].getArray();
+        if (old == nullptr)
+        {
+            std::cerr << "no results in " << file.getFullPathName() << std::endl;
+            return false;
+        }
+
+        std::map<juce::String, double> oldCost;
+        for (auto& o : *old)
+            oldCost[o["key"].toString()] = (double)o["meanUs"];
+
+        int regressions = 0;
+        for (auto& r : results)
+        {
+            auto it = oldCost.find(r.key);
+            if (it == oldCost.end() || it->second < 20.0)
+                continue;
+
+            const double ratio = r.meanUs / it->second;
+            if (ratio > 1.0 + threshold)
+            {
+                ++regressions;
+                std::cout << "REGRESSION " << r.key << ": " << juce::String(it->second, 1) << " -> "
+                          << juce::String(r.meanUs, 1) << " us (x" << juce::String(ratio, 2) << ")" << std::endl;
+            }
+        }
+
+        std::cout << regressions << " regression(s)" << std::endl;
+        return regressions == 0;
+    }
+};
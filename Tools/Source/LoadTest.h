@@ -0,0 +1,213 @@
+// LoadTest.h
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include "ToolUtils.h"
+
+// Many instances in one process, the way a big session runs them: N processors (and
+// optionally N editors) driven by a host callback that keeps real time, on one or more
+// audio threads, while the message thread runs every instance's timers. N doubles each
+// step, so the per-instance columns show where cost stops growing linearly.
+class LoadTest
+{
+public:
+    struct Options
+    {
+        int maxInstances = 256;
+        int numThreads = 1;           // host audio threads, instances split between them
+        bool withEditors = false;     // editors aren't on screen, but their timers run
+        double seconds = 2.0;         // per step
+        double sampleRate = 48000.0;
+        int blockSize = 256;
+    };
+
+    // returns the process exit code
+    static int run(const Options& options)
+    {
+        std::cout << "block " << options.blockSize << " @ " << options.sampleRate << " Hz ("
+                  << juce::String(budgetMs(options), 2) << " ms), " << options.numThreads << " audio thread(s)"
+                  << (options.withEditors ? ", with editors" : "") << std::endl;
+        std::cout << "instances   us/inst/block    dsp cores  process cores   p50 ms   p99 ms   max ms  overruns   MB/inst" << std::endl;
+
+        for (int n = 1; n <= options.maxInstances; n *= 2)
+            print(runStep(n, options), options);
+
+        return 0;
+    }
+
+private:
+    struct Step
+    {
+        int instances = 0;
+        double usPerInstanceBlock = 0.0; // processing time per instance per block
+        double dspCores = 0.0;           // audio work / wall time
+        double processCores = -1.0;      // all threads (timers, baker, message thread) / wall time
+        double p50Ms = 0.0, p99Ms = 0.0, maxMs = 0.0; // whole host callback, per thread
+        juce::int64 overruns = 0;        // callbacks that missed their deadline
+        double mbPerInstance = -1.0;
+    };
+
+    static double budgetMs(const Options& options) { return 1000.0 * options.blockSize / options.sampleRate; }
+
+    // one host audio thread: a slice of the instances, processed once per period
+    struct HostThread
+    {
+        std::vector<LFO2AudioProcessor*> instances;
+        std::vector<juce::AudioBuffer<float>> buffers;  // one per track, as a host would
+        ToolUtils::SyntheticPlayHead playHead;          // every thread sees the same transport
+        std::vector<double> callbackMs;
+        double busyMs = 0.0;
+        juce::int64 blocks = 0, overruns = 0;
+    };
+
+    static Step runStep(int numInstances, const Options& options)
+    {
+        const auto memoryBefore = ToolUtils::residentBytes();
+
+        std::vector<std::unique_ptr<LFO2AudioProcessor>> processors;
+        std::vector<std::unique_ptr<juce::AudioProcessorEditor>> editors;
+        std::vector<HostThread> hosts((size_t)juce::jlimit(1, numInstances, options.numThreads));
+
+        for (int i = 0; i < numInstances; ++i)
+        {
+            auto& host = hosts[(size_t)i % hosts.size()];
+            auto p = std::make_unique<LFO2AudioProcessor>();
+
+            ToolUtils::setChannels(*p, 2);
+            p->setPlayHead(&host.playHead);
+            p->setRateAndBufferSizeDetails(options.sampleRate, options.blockSize);
+            p->prepareToPlay(options.sampleRate, options.blockSize);
+            if (i % 3 == 1)
+                p->requestRateMode(LFO2AudioProcessor::RateMode::HZ); // a mix of modes, like a real session
+
+            if (options.withEditors)
+                editors.emplace_back(p->createEditorIfNeeded());
+
+            host.instances.push_back(p.get());
+            host.buffers.emplace_back(2, options.blockSize);
+            processors.push_back(std::move(p));
+        }
+
+        juce::AudioBuffer<float> input(2, options.blockSize);
+        juce::Random random(7);
+        ToolUtils::fillNoise(input, random);
+
+        for (auto& host : hosts)
+        {
+            host.playHead.sampleRate = options.sampleRate;
+            host.callbackMs.reserve((size_t)(options.seconds * options.sampleRate / options.blockSize) + 16);
+        }
+
+        std::atomic<bool> stop{ false };
+        const double periodMs = budgetMs(options);
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+        const double cpuBefore = ToolUtils::processCpuSeconds();
+
+        std::vector<std::thread> threads;
+        for (auto& host : hosts)
+            threads.emplace_back([&host, &input, &stop, periodMs, startMs]
+            {
+                juce::MidiBuffer midi;
+                double deadline = startMs;
+
+                while (!stop.load())
+                {
+                    const auto start = juce::Time::getHighResolutionTicks();
+                    for (size_t i = 0; i < host.instances.size(); ++i)
+                    {
+                        auto& buffer = host.buffers[i];
+                        for (int ch = 0; ch < 2; ++ch)
+                            buffer.copyFrom(ch, 0, input, ch, 0, input.getNumSamples());
+                        host.instances[i]->processBlock(buffer, midi);
+                    }
+                    const double ms = ToolUtils::ticksToNs(juce::Time::getHighResolutionTicks() - start) * 1.0e-6;
+
+                    host.callbackMs.push_back(ms);
+                    host.busyMs += ms;
+                    host.playHead.advance(host.buffers.front().getNumSamples());
+                    ++host.blocks;
+
+                    // wait for the next period like a sound card would; late means an overrun
+                    deadline += periodMs;
+                    auto now = juce::Time::getMillisecondCounterHiRes();
+                    if (now > deadline)
+                    {
+                        ++host.overruns;
+                        deadline = now; // a real host drops the buffer and carries on
+                    }
+                    while ((now = juce::Time::getMillisecondCounterHiRes()) < deadline)
+                    {
+                        if (deadline - now > 1.5)
+                            juce::Thread::sleep(1);
+                        else
+                            std::this_thread::yield();
+                    }
+                }
+            });
+
+        // meanwhile the message thread runs every instance's timers and async updates
+        juce::MessageManager::getInstance()->runDispatchLoopUntil((int)(options.seconds * 1000.0));
+        stop = true;
+        for (auto& t : threads)
+            t.join();
+
+        const double wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startMs) / 1000.0;
+        const double cpuAfter = ToolUtils::processCpuSeconds();
+        const auto memoryAfter = ToolUtils::residentBytes();
+
+        Step step;
+        step.instances = numInstances;
+
+        std::vector<double> callbacks;
+        double busyMs = 0.0;
+        juce::int64 instanceBlocks = 0;
+        for (auto& host : hosts)
+        {
+            callbacks.insert(callbacks.end(), host.callbackMs.begin(), host.callbackMs.end());
+            busyMs += host.busyMs;
+            instanceBlocks += host.blocks * (juce::int64)host.instances.size();
+            step.overruns += host.overruns;
+        }
+
+        step.usPerInstanceBlock = instanceBlocks > 0 ? busyMs * 1000.0 / (double)instanceBlocks : 0.0;
+        step.dspCores = busyMs / 1000.0 / wallSeconds;
+        if (cpuBefore >= 0.0 && cpuAfter >= 0.0)
+            step.processCores = (cpuAfter - cpuBefore) / wallSeconds;
+        if (memoryBefore >= 0 && memoryAfter >= 0)
+            step.mbPerInstance = (double)(memoryAfter - memoryBefore) / (1024.0 * 1024.0) / numInstances;
+
+        std::sort(callbacks.begin(), callbacks.end());
+        step.p50Ms = ToolUtils::percentile(callbacks, 0.50);
+        step.p99Ms = ToolUtils::percentile(callbacks, 0.99);
+        step.maxMs = callbacks.empty() ? 0.0 : callbacks.back();
+
+        // editors go before their processors, like a host closing the session
+        editors.clear();
+        for (auto& p : processors)
+        {
+            p->releaseResources();
+            p->setPlayHead(nullptr);
+        }
+        return step;
+    }
+
+    static void print(const Step& s, const Options& options)
+    {
+        auto orNA = [](double v, int places) { return v < 0.0 ? juce::String("n/a") : juce::String(v, places); };
+        const bool late = s.p99Ms > budgetMs(options);
+
+        std::cout << juce::String(s.instances).paddedLeft(' ', 9)
+                  << juce::String(s.usPerInstanceBlock, 2).paddedLeft(' ', 16)
+                  << juce::String(s.dspCores, 3).paddedLeft(' ', 13)
+                  << orNA(s.processCores, 3).paddedLeft(' ', 15)
+                  << juce::String(s.p50Ms, 3).paddedLeft(' ', 9)
+                  << juce::String(s.p99Ms, 3).paddedLeft(' ', 9)
+                  << juce::String(s.maxMs, 3).paddedLeft(' ', 9)
+                  << juce::String(s.overruns).paddedLeft(' ', 10)
+                  << orNA(s.mbPerInstance, 3).paddedLeft(' ', 10)
+                  << (late ? "   <- p99 past the deadline" : "") << std::endl;
+    }
+};
@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+    Chronos developer tools: headless benchmarks and checks that run the real
+    plugin processor outside a host.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ProcessBlockBench.h"
+#include "GuiBench.h"
+#include "RealtimeStress.h"
+#include "BatchRenderer.h"
+#include "LoadTest.h"
+#include <iostream>
+
+namespace
+{
+    int runBench(const juce::ArgumentList& args)
+    {
+        ProcessBlockBench::Options options;
+        options.quick = args.containsOption("--quick");
+
+        if (args.containsOption("--seconds"))
+            options.secondsPerConfig = juce::jmax(0.01, args.getValueForOption("--seconds").getDoubleValue());
+        if (args.containsOption("--out"))
+            options.output = args.getFileForOption("--out");
+        if (args.containsOption("--compare"))
+            options.compareTo = args.getExistingFileForOption("--compare");
+        if (args.containsOption("--threshold"))
+            options.regressionThreshold = args.getValueForOption("--threshold").getDoubleValue() / 100.0;
+        if (args.containsOption("--bands"))
+            options.bands = juce::jlimit(1, Multiband::maxBands, args.getValueForOption("--bands").getIntValue());
+
+        return ProcessBlockBench::run(options);
+    }
+
+    int runGuiBench(const juce::ArgumentList& args)
+    {
+        GuiBench::Options options;
+        options.quick = args.containsOption("--quick");
+
+        if (args.containsOption("--frames"))
+            options.frames = juce::jmax(1, args.getValueForOption("--frames").getIntValue());
+        if (args.containsOption("--out"))
+            options.output = args.getFileForOption("--out");
+        if (args.containsOption("--compare"))
+            options.compareTo = args.getExistingFileForOption("--compare");
+        if (args.containsOption("--threshold"))
+            options.regressionThreshold = args.getValueForOption("--threshold").getDoubleValue() / 100.0;
+
+        return GuiBench::run(options);
+    }
+
+    int runRealtimeCheck(const juce::ArgumentList& args)
+    {
+        RealtimeStress::Options options;
+        options.breakOnViolation = args.containsOption("--break");
+
+        if (args.containsOption("--seconds"))
+            options.seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+        if (args.containsOption("--block"))
+            options.blockSize = juce::jlimit(1, 8192, args.getValueForOption("--block").getIntValue());
+
+        return RealtimeStress::run(options);
+    }
+
+    int runLoadTest(const juce::ArgumentList& args)
+    {
+        LoadTest::Options options;
+        options.withEditors = args.containsOption("--editors");
+
+        if (args.containsOption("--max"))
+            options.maxInstances = juce::jlimit(1, 4096, args.getValueForOption("--max").getIntValue());
+        if (args.containsOption("--threads"))
+            options.numThreads = juce::jlimit(1, 64, args.getValueForOption("--threads").getIntValue());
+        if (args.containsOption("--seconds"))
+            options.seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+        if (args.containsOption("--block"))
+            options.blockSize = juce::jlimit(16, 8192, args.getValueForOption("--block").getIntValue());
+        if (args.containsOption("--rate"))
+            options.sampleRate = juce::jlimit(8000.0, 384000.0, args.getValueForOption("--rate").getDoubleValue());
+
+        return LoadTest::run(options);
+    }
+
+    int runRender(const juce::ArgumentList& args)
+    {
+        BatchRenderer::Options options;
+
+        // inputs: plain arguments, a list file, and/or paths piped in on stdin ("-")
+        bool readStdin = false;
+        for (int i = 1; i < args.size(); ++i)
+        {
+            if (args[i].text == "-")
+                readStdin = true;
+            else if (!args[i].isOption())
+                options.inputs.add(args[i].text);
+        }
+
+        if (args.containsOption("--list"))
+            options.inputs.addLines(args.getExistingFileForOption("--list").loadFileAsString());
+
+        if (readStdin)
+            for (std::string line; std::getline(std::cin, line);)
+                options.inputs.add(juce::String(line));
+
+        options.inputs.trim();
+        options.inputs.removeEmptyStrings();
+
+        if (args.containsOption("--out-dir"))  options.outputDir = args.getFileForOption("--out-dir");
+        if (args.containsOption("--suffix"))   options.suffix = args.getValueForOption("--suffix");
+        if (args.containsOption("--threads"))  options.numThreads = juce::jmax(1, args.getValueForOption("--threads").getIntValue());
+        if (args.containsOption("--chunk"))    options.chunkSize = juce::jlimit(16, 65536, args.getValueForOption("--chunk").getIntValue());
+        if (args.containsOption("--bits"))     options.bitDepth = args.getValueForOption("--bits").getIntValue();
+        if (args.containsOption("--bpm"))      options.bpm = juce::jlimit(20.0, 999.0, args.getValueForOption("--bpm").getDoubleValue());
+        if (args.containsOption("--preset"))   options.preset = args.getValueForOption("--preset");
+        if (args.containsOption("--division")) options.division = args.getValueForOption("--division").getFloatValue();
+        if (args.containsOption("--hz"))       options.hz = args.getValueForOption("--hz").getFloatValue();
+        if (args.containsOption("--mix"))      options.mix = args.getValueForOption("--mix").getFloatValue();
+
+        if (args.containsOption("--mode"))
+        {
+            auto mode = args.getValueForOption("--mode").toLowerCase();
+            if (mode == "bpm")         options.mode = LFO2AudioProcessor::RateMode::BPM;
+            else if (mode == "hz")     options.mode = LFO2AudioProcessor::RateMode::HZ;
+            else if (mode == "bpm/hz") options.mode = LFO2AudioProcessor::RateMode::BPM_HZ;
+            else juce::ConsoleApplication::fail("unknown --mode '" + mode + "' (bpm, hz or bpm/hz)");
+        }
+
+        return BatchRenderer::run(options);
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit; // the processor owns timers/threads that expect a message manager
+
+    juce::ConsoleApplication app;
+    app.addHelpCommand("--help|-h", "Chronos developer tools", true);
+
+    app.addCommand({ "bench",
+                     "bench [--quick] [--seconds=N] [--bands=2..4] [--out=baseline.json] [--compare=baseline.json] [--threshold=percent]",
+                     "Times processBlock across block sizes, sample rates, channels, rate modes and shapes",
+                     "Runs LFO2AudioProcessor headless with a synthetic playhead and reports ns/sample,\n"
+                     "per-block percentiles and allocations per configuration. --out writes a JSON baseline,\n"
+                     "--compare fails (exit code 1) on any configuration that got slower than the threshold\n"
+                     "(default 10%) or that allocates. --bands runs every configuration through the\n"
+                     "multiband split (keys get a \"/Nband\" suffix, so compare against a baseline made the same way).",
+                     [](const juce::ArgumentList& args) { if (int code = runBench(args)) juce::ConsoleApplication::fail({}, code); } });
+
+    app.addCommand({ "guibench",
+                     "guibench [--quick] [--frames=N] [--out=baseline.json] [--compare=baseline.json] [--threshold=percent]",
+                     "Times editor painting offscreen and point drags on big curves",
+                     "Paints the editor into an offscreen image at several sizes and scale factors and reports\n"
+                     "per-frame time split into chrome, curve, glows, knobs and other controls. Then drags a\n"
+                     "point on curves with 3, 100 and 2000 points and times the mouse handler and repaint.\n"
+                     "--out/--compare work like bench (default threshold 15%, entries under 20us ignored).",
+                     [](const juce::ArgumentList& args) { if (int code = runGuiBench(args)) juce::ConsoleApplication::fail({}, code); } });
+
+    app.addCommand({ "rtcheck",
+                     "rtcheck [--seconds=N] [--block=N] [--break]",
+                     "Fails if processBlock allocates, locks, waits or makes a blocking call",
+                     "Runs processBlock on its own thread while other threads hammer it with curve edits,\n"
+                     "mode/rate changes, automation, state save/restore and preset loads. Allocation, lock,\n"
+                     "wait and blocking system calls inside the callback are counted (full coverage on\n"
+                     "Linux/glibc, operator new only elsewhere). Exit code 1 on any violation; --break\n"
+                     "raises SIGTRAP at the first one so a debugger shows the culprit.",
+                     [](const juce::ArgumentList& args) { if (int code = runRealtimeCheck(args)) juce::ConsoleApplication::fail({}, code); } });
+
+    app.addCommand({ "loadtest",
+                     "loadtest [--max=N] [--threads=N] [--editors] [--seconds=N] [--block=N] [--rate=N]",
+                     "Runs 1, 2, 4 ... N instances in one process and reports how cost scales",
+                     "Creates N processors (and with --editors, N editors with their timers running) and\n"
+                     "drives them from a real-time paced host callback on --threads audio threads, while the\n"
+                     "message thread runs. Each step prints time per instance per block, audio and whole-\n"
+                     "process CPU in cores, callback p50/p99/max against the deadline, overruns and resident\n"
+                     "memory per instance (process CPU and memory are Linux/macOS only).",
+                     [](const juce::ArgumentList& args) { if (int code = runLoadTest(args)) juce::ConsoleApplication::fail({}, code); } });
+
+    app.addCommand({ "render",
+                     "render [files...] [-] [--list=paths.txt] [--out-dir=dir] [--threads=N] [--chunk=N] [--bpm=N]\n"
+                     "       [--preset=name|index] [--mode=bpm|hz|bpm/hz] [--division=beats] [--hz=N] [--mix=0..1] [--bits=16|24|32]",
+                     "Renders audio files through the processor offline, in parallel",
+                     "Each file gets a fresh processor with the given tempo, preset and rate settings, and is\n"
+                     "streamed through it in fixed-size chunks to <name>.chronos.wav. Files come from the\n"
+                     "arguments, a list file, or stdin with '-'. Exit code 1 if any file fails.",
+                     [](const juce::ArgumentList& args) { if (int code = runRender(args)) juce::ConsoleApplication::fail({}, code); } });
+
+    return app.findAndRunCommand(argc, argv);
+}
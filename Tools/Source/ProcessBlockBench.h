@@ -0,0 +1,294 @@
+// ProcessBlockBench.h
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <map>
+#include <iostream>
+#include "ToolUtils.h"
+#include "AllocationHooks.h"
+
+// Times LFO2AudioProcessor::processBlock over every block size / sample rate / channel
+// count / rate mode / shape, with a synthetic playhead and no editor. Results go to a
+// JSON baseline that a later run can be compared against.
+class ProcessBlockBench
+{
+public:
+    struct Options
+    {
+        bool quick = false;          // fewer configurations, for a smoke run
+        double secondsPerConfig = 0.5; // audio rendered per configuration
+        juce::File output;           // baseline to write (optional)
+        juce::File compareTo;        // baseline to compare against (optional)
+        double regressionThreshold = 0.10; // fail a comparison if ns/sample grows more than this
+        int bands = 1;               // >1 runs everything through the multiband split
+    };
+
+    struct Result
+    {
+        double sampleRate = 0.0;
+        int blockSize = 0;
+        int channels = 0;
+        juce::String mode, shape;
+        int bands = 1;
+
+        double nsPerSample = 0.0;          // mean
+        double p50 = 0.0, p90 = 0.0, p99 = 0.0, max = 0.0; // ns per block
+        juce::int64 allocations = 0;
+
+        juce::String key() const
+        {
+            return juce::String(sampleRate, 0) + "/" + juce::String(blockSize) + "/" + juce::String(channels)
+                 + "/" + mode + "/" + shape + (bands > 1 ? "/" + juce::String(bands) + "band" : juce::String());
+        }
+    };
+
+    // returns the process exit code
+    static int run(const Options& options)
+    {
+        std::vector<double> sampleRates{ 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+        std::vector<int> blockSizes{ 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+        std::vector<int> channelCounts{ 1, 2 };
+
+        if (options.quick)
+        {
+            sampleRates = { 48000.0 };
+            blockSizes = { 16, 256, 4096 };
+            channelCounts = { 2 };
+        }
+
+        const LFO2AudioProcessor::RateMode modes[] = { LFO2AudioProcessor::RateMode::BPM,
+                                                       LFO2AudioProcessor::RateMode::HZ,
+                                                       LFO2AudioProcessor::RateMode::BPM_HZ };
+
+        std::vector<Result> results;
+
+        for (auto sr : sampleRates)
+            for (auto block : blockSizes)
+                for (auto ch : channelCounts)
+                    for (auto mode : modes)
+                        for (int shape = 0; shape < numShapeVariants; ++shape)
+                        {
+                            auto r = runOne(sr, block, ch, mode, shape, options.bands, options.secondsPerConfig);
+                            print(r);
+                            results.push_back(r);
+                        }
+
+        if (options.output != juce::File())
+        {
+            if (!writeBaseline(results, options.output))
+            {
+                std::cerr << "couldn't write " << options.output.getFullPathName() << std::endl;
+                return 1;
+            }
+            std::cout << "baseline written to " << options.output.getFullPathName() << std::endl;
+        }
+
+        if (options.compareTo != juce::File())
+            return compare(results, options.compareTo, options.regressionThreshold) ? 0 : 1;
+
+        return 0;
+    }
+
+private:
+    // the analytic shapes, then a custom table, then custom + morph table, then the two
+    // random shapes (fixed seed, humanize on, so the per-cycle draws are in the timing)
+    static constexpr int numShapeVariants = 8;
+    static constexpr int customMorphVariant = 5;
+
+    static LFO::Shape randomShapeFor(int variant) { return variant == 6 ? LFO::Shape::RandomStep : LFO::Shape::RandomSmooth; }
+
+    static juce::String shapeVariantName(int variant)
+    {
+        if (variant == customMorphVariant) return "Custom+Morph";
+        if (variant > customMorphVariant)  return ToolUtils::shapeName(randomShapeFor(variant));
+        return ToolUtils::shapeName((LFO::Shape)variant);
+    }
+
+    static Result runOne(double sampleRate, int blockSize, int numChannels,
+                         LFO2AudioProcessor::RateMode mode, int shapeVariant, int numBands, double seconds)
+    {
+        LFO2AudioProcessor processor;
+        ToolUtils::SyntheticPlayHead playHead;
+        playHead.sampleRate = sampleRate;
+
+        ToolUtils::setChannels(processor, numChannels);
+        processor.setPlayHead(&playHead);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        processor.multiband.numBands = numBands;
+        for (size_t b = 0; b < (size_t)numBands; ++b)
+            processor.multiband.bands[b].phaseOffset = 0.25f * (float)b; // every band doing its own LFO work
+
+        processor.requestRateMode(mode);
+        if (mode != LFO2AudioProcessor::RateMode::BPM)
+            processor.requestHz(3.7f); // off the grid, so BPM/Hz stays free running
+
+        if (shapeVariant <= (int)LFO::Shape::Square)
+        {
+            processor.lfo.setShape((LFO::Shape)shapeVariant);
+            processor.lfo.clearCustomWaveform();
+            processor.lfo.clearMorphWaveform();
+        }
+        else if (shapeVariant > customMorphVariant)
+        {
+            processor.lfo.setShape(randomShapeFor(shapeVariant));
+            processor.lfo.clearCustomWaveform();
+            processor.lfo.clearMorphWaveform();
+            processor.randomSeed = 1234; // same draws every run
+            processor.humanize = 0.5f;
+        }
+        else
+        {
+            // tables go in directly rather than through the baker, so they're in place before timing
+            Curve curve;
+            curve.points = { {0.0f, 0.0f}, {0.2f, 1.0f}, {0.45f, 0.3f}, {0.7f, 0.9f}, {1.0f, 0.0f} };
+            curve.syncSegments();
+            processor.lfo.setShape(LFO::Shape::Custom);
+            processor.lfo.setCustomWaveform(curve.createSampleBuffer(1024, true));
+
+            if (shapeVariant == customMorphVariant)
+            {
+                curve.points = { {0.0f, 1.0f}, {0.5f, 0.0f}, {1.0f, 1.0f} };
+                curve.syncSegments();
+                processor.lfo.setMorphWaveform(curve.createSampleBuffer(1024, true));
+                *processor.morphParam = 0.5f;
+            }
+        }
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(0x5eed);
+        ToolUtils::fillNoise(buffer, random);
+
+        // warm up: applies the queued commands, faults in tables and caches
+        for (int i = 0; i < 16; ++i)
+        {
+            processor.processBlock(buffer, midi);
+            playHead.advance(blockSize);
+        }
+
+        const int numBlocks = juce::jmax(64, (int)(seconds * sampleRate / blockSize));
+        std::vector<double> blockNs;
+        blockNs.reserve((size_t)numBlocks);
+
+        AllocationHooks::beginWatchingThisThread();
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            processor.processBlock(buffer, midi);
+            const auto end = juce::Time::getHighResolutionTicks();
+
+            blockNs.push_back(ToolUtils::ticksToNs(end - start));
+            playHead.advance(blockSize);
+
+            // keep the signal from decaying to denormals/zero under repeated gain
+            if ((i & 63) == 63)
+                ToolUtils::fillNoise(buffer, random);
+        }
+        const auto allocations = AllocationHooks::endWatchingThisThread();
+
+        processor.releaseResources();
+        processor.setPlayHead(nullptr);
+
+        Result r;
+        r.sampleRate = sampleRate;
+        r.blockSize = blockSize;
+        r.channels = numChannels;
+        r.mode = ToolUtils::modeName(mode);
+        r.shape = shapeVariantName(shapeVariant);
+        r.bands = numBands;
+        r.allocations = allocations;
+
+        double total = 0.0;
+        for (auto ns : blockNs)
+            total += ns;
+        r.nsPerSample = total / ((double)numBlocks * blockSize);
+
+        std::sort(blockNs.begin(), blockNs.end());
+        r.p50 = ToolUtils::percentile(blockNs, 0.50);
+        r.p90 = ToolUtils::percentile(blockNs, 0.90);
+        r.p99 = ToolUtils::percentile(blockNs, 0.99);
+        r.max = blockNs.back();
+        return r;
+    }
+
+    static void print(const Result& r)
+    {
+        std::cout << r.key().paddedRight(' ', 36)
+                  << juce::String(r.nsPerSample, 2).paddedLeft(' ', 9) << " ns/sample"
+                  << "   p50 " << juce::String(r.p50 / 1000.0, 2) << "us"
+                  << "  p99 " << juce::String(r.p99 / 1000.0, 2) << "us"
+                  << "  max " << juce::String(r.max / 1000.0, 2) << "us"
+                  << "  allocs " << r.allocations << std::endl;
+    }
+
+    static bool writeBaseline(const std::vector<Result>& results, const juce::File& file)
+    {
+        juce::Array<juce::var> list;
+        for (auto& r : results)
+        {
+            auto* o = new juce::DynamicObject();
+            o->setProperty("key", r.key());
+            o->setProperty("sampleRate", r.sampleRate);
+            o->setProperty("blockSize", r.blockSize);
+            o->setProperty("channels", r.channels);
+            o->setProperty("mode", r.mode);
+            o->setProperty("shape", r.shape);
+            o->setProperty("bands", r.bands);
+            o->setProperty("nsPerSample", r.nsPerSample);
+            o->setProperty("p50Ns", r.p50);
+            o->setProperty("p90Ns", r.p90);
+            o->setProperty("p99Ns", r.p99);
+            o->setProperty("maxNs", r.max);
+            o->setProperty("allocations", r.allocations);
+            list.add(juce::var(o));
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("tool", "chronos-bench");
+        root->setProperty("version", 2); // 2: RandomStep/RandomSmooth keys added
+        root->setProperty("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty("results", list);
+
+        return file.replaceWithText(juce::JSON::toString(juce::var(root)));
+    }
+
+    // per configuration: ratio of new to old ns/sample, failing anything past the threshold
+    static bool compare(const std::vector<Result>& results, const juce::File& file, double threshold)
+    {
+        auto baseline = juce::JSON::parse(file);
+        auto* old = baseline["results"].getArray();
+        if (old == nullptr)
+        {
+            std::cerr << "no results in " << file.getFullPathName() << std::endl;
+            return false;
+        }
+
+        std::map<juce::String, double> oldCost;
+        for (auto& o : *old)
+            oldCost[o["key"].toString()] = (double)o["nsPerSample"];
+
+        int regressions = 0, allocating = 0;
+        for (auto& r : results)
+        {
+            if (r.allocations > 0)
+                ++allocating;
+
+            auto it = oldCost.find(r.key());
+            if (it == oldCost.end() || it->second <= 0.0)
+                continue;
+
+            const double ratio = r.nsPerSample / it->second;
+            if (ratio > 1.0 + threshold)
+            {
+                ++regressions;
+                std::cout << "REGRESSION " << r.key() << ": " << juce::String(it->second, 2) << " -> "
+                          << juce::String(r.nsPerSample, 2) << " ns/sample (x" << juce::String(ratio, 2) << ")" << std::endl;
+            }
+        }
+
+        std::cout << regressions << " regression(s), " << allocating << " configuration(s) allocating" << std::endl;
+        return regressions == 0 && allocating == 0;
+    }
+};
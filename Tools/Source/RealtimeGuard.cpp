@@ -0,0 +1,168 @@
+// RealtimeGuard.cpp
+#include "RealtimeGuard.h"
+#include <atomic>
+#include <csignal>
+
+namespace
+{
+    thread_local int callbackDepth = 0;
+    thread_local bool reporting = false; // the bookkeeping below must never report itself
+
+    // fixed table so reporting never allocates; keyed by the literal's address
+    struct Entry
+    {
+        std::atomic<const char*> what{ nullptr };
+        std::atomic<int64_t> count{ 0 };
+    };
+
+    constexpr int maxEntries = 64;
+    Entry entries[maxEntries];
+    std::atomic<bool> breakOnViolation{ false };
+
+    void record(const char* what)
+    {
+        for (auto& e : entries)
+        {
+            auto* current = e.what.load(std::memory_order_acquire);
+            if (current == nullptr)
+            {
+                const char* expected = nullptr;
+                if (e.what.compare_exchange_strong(expected, what) || expected == what)
+                {
+                    e.count.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                continue;
+            }
+
+            if (current == what)
+            {
+                e.count.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+}
+
+RealtimeGuard::ScopedAudioCallback::ScopedAudioCallback() { ++callbackDepth; }
+RealtimeGuard::ScopedAudioCallback::~ScopedAudioCallback() { --callbackDepth; }
+
+bool RealtimeGuard::isInAudioCallback() { return callbackDepth > 0; }
+
+void RealtimeGuard::report(const char* what)
+{
+    if (callbackDepth == 0 || reporting)
+        return;
+
+    reporting = true;
+    record(what);
+    if (breakOnViolation.load(std::memory_order_relaxed))
+        std::raise(SIGTRAP);
+    reporting = false;
+}
+
+void RealtimeGuard::setBreakOnViolation(bool shouldBreak) { breakOnViolation = shouldBreak; }
+
+std::vector<RealtimeGuard::Violation> RealtimeGuard::getViolations()
+{
+    std::vector<Violation> result;
+    for (auto& e : entries)
+        if (auto* what = e.what.load())
+            if (auto n = e.count.load())
+                result.push_back({ what, n });
+    return result;
+}
+
+void RealtimeGuard::reset()
+{
+    for (auto& e : entries)
+        e.count = 0;
+}
+
+//==============================================================================
+// Linux/glibc interposers. The executable's definitions win over libc's for everything
+// linked into it (JUCE included) and, with -rdynamic, for shared libraries too.
+#if defined(__linux__) && defined(__GLIBC__)
+#include <dlfcn.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <unistd.h>
+#include <time.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void  __libc_free(void*);
+    void* __libc_memalign(size_t, size_t);
+}
+
+namespace
+{
+    // looked up on first use; a plain atomic rather than a function static, because
+    // a static's init guard can itself take pthread_mutex_lock and recurse in here
+    template <typename Fn>
+    Fn next(std::atomic<void*>& cache, const char* name)
+    {
+        auto* p = cache.load(std::memory_order_acquire);
+        if (p == nullptr)
+        {
+            p = dlsym(RTLD_NEXT, name);
+            cache.store(p, std::memory_order_release);
+        }
+        return reinterpret_cast<Fn>(p);
+    }
+}
+
+#define CHRONOS_RT_FORWARD(ret, name, params, args)                              \
+    extern "C" ret name params                                                   \
+    {                                                                            \
+        RealtimeGuard::report(#name);                                            \
+        static std::atomic<void*> real{ nullptr };                               \
+        return next<ret (*) params>(real, #name) args;                           \
+    }
+
+extern "C" void* malloc(size_t size)               { RealtimeGuard::report("malloc");  return __libc_malloc(size); }
+extern "C" void* calloc(size_t n, size_t size)     { RealtimeGuard::report("calloc");  return __libc_calloc(n, size); }
+extern "C" void* realloc(void* p, size_t size)     { RealtimeGuard::report("realloc"); return __libc_realloc(p, size); }
+extern "C" void  free(void* p)                     { if (p != nullptr) RealtimeGuard::report("free"); __libc_free(p); }
+extern "C" void* memalign(size_t align, size_t size) { RealtimeGuard::report("memalign"); return __libc_memalign(align, size); }
+
+extern "C" int posix_memalign(void** out, size_t align, size_t size)
+{
+    RealtimeGuard::report("posix_memalign");
+    if (align < sizeof(void*) || (align & (align - 1)) != 0)
+        return 22; // EINVAL
+    *out = __libc_memalign(align, size);
+    return *out != nullptr ? 0 : 12; // ENOMEM
+}
+
+extern "C" void* aligned_alloc(size_t align, size_t size) { RealtimeGuard::report("aligned_alloc"); return __libc_memalign(align, size); }
+
+// locks and waits
+CHRONOS_RT_FORWARD(int, pthread_mutex_lock, (pthread_mutex_t* m), (m))
+CHRONOS_RT_FORWARD(int, pthread_mutex_trylock, (pthread_mutex_t* m), (m))
+CHRONOS_RT_FORWARD(int, pthread_rwlock_rdlock, (pthread_rwlock_t* l), (l))
+CHRONOS_RT_FORWARD(int, pthread_rwlock_wrlock, (pthread_rwlock_t* l), (l))
+CHRONOS_RT_FORWARD(int, pthread_cond_wait, (pthread_cond_t* c, pthread_mutex_t* m), (c, m))
+CHRONOS_RT_FORWARD(int, pthread_cond_timedwait, (pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t), (c, m, t))
+CHRONOS_RT_FORWARD(int, pthread_join, (pthread_t t, void** r), (t, r))
+CHRONOS_RT_FORWARD(int, sem_wait, (sem_t* s), (s))
+CHRONOS_RT_FORWARD(int, sem_timedwait, (sem_t* s, const struct timespec* t), (s, t))
+
+// system calls that block or can
+CHRONOS_RT_FORWARD(ssize_t, read, (int fd, void* buf, size_t n), (fd, buf, n))
+CHRONOS_RT_FORWARD(ssize_t, write, (int fd, const void* buf, size_t n), (fd, buf, n))
+CHRONOS_RT_FORWARD(int, close, (int fd), (fd))
+CHRONOS_RT_FORWARD(int, usleep, (useconds_t us), (us))
+CHRONOS_RT_FORWARD(int, nanosleep, (const struct timespec* req, struct timespec* rem), (req, rem))
+CHRONOS_RT_FORWARD(int, clock_nanosleep, (clockid_t c, int flags, const struct timespec* req, struct timespec* rem), (c, flags, req, rem))
+CHRONOS_RT_FORWARD(int, sched_yield, (void), ())
+CHRONOS_RT_FORWARD(void*, mmap, (void* addr, size_t len, int prot, int flags, int fd, off_t off), (addr, len, prot, flags, fd, off))
+CHRONOS_RT_FORWARD(int, munmap, (void* addr, size_t len), (addr, len))
+
+#undef CHRONOS_RT_FORWARD
+#endif
@@ -0,0 +1,36 @@
+// RealtimeGuard.h
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <string>
+
+// Flags anything real-time unsafe done by a thread while it's inside the audio callback.
+// On Linux (glibc) RealtimeGuard.cpp interposes malloc/free, pthread locks and waits, and a
+// handful of blocking system calls; the operator new hook in AllocationHooks.cpp reports too.
+// Other platforms only see operator new. Tools build only - the plugin never links this.
+namespace RealtimeGuard
+{
+    // mark the calling thread as running the audio callback
+    struct ScopedAudioCallback
+    {
+        ScopedAudioCallback();
+        ~ScopedAudioCallback();
+    };
+
+    bool isInAudioCallback();
+
+    // called by the hooks; 'what' must be a string literal. No-op outside the callback.
+    void report(const char* what);
+
+    // raise SIGTRAP on the first violation, so a debugger stops right on it
+    void setBreakOnViolation(bool shouldBreak);
+
+    struct Violation
+    {
+        std::string what;
+        int64_t count = 0;
+    };
+
+    std::vector<Violation> getViolations();
+    void reset();
+}
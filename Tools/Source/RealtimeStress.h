@@ -0,0 +1,154 @@
+// RealtimeStress.h
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <thread>
+#include <iostream>
+#include "ToolUtils.h"
+#include "RealtimeGuard.h"
+
+// Runs processBlock flat out on an "audio" thread under RealtimeGuard while other threads
+// do what the GUI, the host's automation and its state saving would do, all at once.
+// Any allocation, lock, wait or blocking call seen inside processBlock fails the run.
+class RealtimeStress
+{
+public:
+    struct Options
+    {
+        double seconds = 5.0;
+        double sampleRate = 48000.0;
+        int blockSize = 256;
+        bool breakOnViolation = false;
+    };
+
+    // returns the process exit code
+    static int run(const Options& options)
+    {
+        RealtimeGuard::reset();
+        RealtimeGuard::setBreakOnViolation(options.breakOnViolation);
+
+        LFO2AudioProcessor processor;
+        ToolUtils::SyntheticPlayHead playHead;
+        playHead.sampleRate = options.sampleRate;
+
+        ToolUtils::setChannels(processor, 2);
+        processor.setPlayHead(&playHead);
+        processor.setRateAndBufferSizeDetails(options.sampleRate, options.blockSize);
+        processor.prepareToPlay(options.sampleRate, options.blockSize);
+
+        std::atomic<bool> stop{ false };
+        std::atomic<juce::int64> blocks{ 0 }, edits{ 0 }, automation{ 0 }, stateLoads{ 0 };
+
+        std::thread audio([&]
+        {
+            juce::AudioBuffer<float> buffer(2, options.blockSize);
+            juce::MidiBuffer midi;
+            juce::Random random(1);
+
+            while (!stop.load())
+            {
+                // hosts send short blocks too
+                const int n = random.nextInt(4) == 0 ? 1 + random.nextInt(options.blockSize) : options.blockSize;
+                juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, n);
+                ToolUtils::fillNoise(block, random);
+
+                // the transport does things a real one does: tempo changes, stops, loops
+                if (random.nextInt(200) == 0) playHead.bpm = 60.0 + random.nextInt(140);
+                if (random.nextInt(500) == 0) playHead.playing = !playHead.playing;
+                if (random.nextInt(300) == 0) playHead.samplePosition = 0;
+
+                {
+                    RealtimeGuard::ScopedAudioCallback inCallback;
+                    processor.processBlock(block, midi);
+                }
+
+                playHead.advance(n);
+                ++blocks;
+            }
+        });
+
+        // the editor: curve drags, mode buttons, rate slider
+        std::thread gui([&]
+        {
+            juce::Random random(2);
+            while (!stop.load())
+            {
+                Curve curve;
+                curve.points.clear();
+                const int numPoints = 2 + random.nextInt(40);
+                for (int i = 0; i < numPoints; ++i)
+                    curve.points.push_back({ (float)i / (float)(numPoints - 1), random.nextFloat() });
+                curve.syncSegments();
+                for (auto& s : curve.segments)
+                    s.tension = random.nextFloat() * 2.0f - 1.0f;
+
+                processor.curveEdited(curve, random.nextBool());
+
+                switch (random.nextInt(5))
+                {
+                case 0: processor.requestRateMode((LFO2AudioProcessor::RateMode)random.nextInt(3)); break;
+                case 1: processor.requestDivision(std::pow(2.0f, (float)(random.nextInt(7) - 3))); break;
+                case 2: processor.requestHz(0.1f + random.nextFloat() * 15.0f); break;
+                case 3: processor.requestSnap(std::pow(2.0f, (float)(random.nextInt(5) - 2))); break;
+                default: processor.lfo.setShape((LFO::Shape)random.nextInt(4)); break;
+                }
+
+                ++edits;
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+            }
+        });
+
+        // host automation
+        std::thread automate([&]
+        {
+            juce::Random random(3);
+            while (!stop.load())
+            {
+                processor.morphParam->setValueNotifyingHost(random.nextFloat());
+                ++automation;
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        });
+
+        // host saving/restoring the session, and preset loads
+        std::thread state([&]
+        {
+            juce::Random random(4);
+            while (!stop.load())
+            {
+                juce::MemoryBlock chunk;
+                processor.getStateInformation(chunk);
+                processor.setStateInformation(chunk.getData(), (int)chunk.getSize());
+
+                if (auto numPresets = processor.getPresetBank().size(); numPresets > 0)
+                    processor.loadPreset(random.nextInt(numPresets));
+
+                ++stateLoads;
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        });
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(options.seconds));
+        stop = true;
+        for (auto* t : { &audio, &gui, &automate, &state })
+            t->join();
+
+        processor.releaseResources();
+        processor.setPlayHead(nullptr);
+
+        std::cout << blocks.load() << " blocks, " << edits.load() << " GUI edits, " << automation.load()
+                  << " automation changes, " << stateLoads.load() << " state loads" << std::endl;
+
+        auto violations = RealtimeGuard::getViolations();
+        if (violations.empty())
+        {
+            std::cout << "no real-time violations in processBlock" << std::endl;
+            return 0;
+        }
+
+        std::cout << "REAL-TIME VIOLATIONS in processBlock:" << std::endl;
+        for (auto& v : violations)
+            std::cout << "  " << v.what << " x" << v.count << std::endl;
+        return 1;
+    }
+};
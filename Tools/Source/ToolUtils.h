@@ -0,0 +1,129 @@
+// ToolUtils.h
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <algorithm>
+#include "../../Source/PluginProcessor.h"
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <cstdio>
+ #include <unistd.h>
+ #include <sys/resource.h>
+#endif
+
+namespace ToolUtils
+{
+    // a host transport that just plays: fixed tempo, ppq advanced by each block
+    class SyntheticPlayHead : public juce::AudioPlayHead
+    {
+    public:
+        double bpm = 120.0;
+        double sampleRate = 48000.0;
+        bool playing = true;
+        juce::int64 samplePosition = 0;
+
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            PositionInfo info;
+            info.setBpm(bpm);
+            info.setTimeInSamples(samplePosition);
+            info.setTimeInSeconds((double)samplePosition / sampleRate);
+            info.setPpqPosition((double)samplePosition / sampleRate * bpm / 60.0);
+            info.setTimeSignature(juce::AudioPlayHead::TimeSignature{});
+            info.setIsPlaying(playing);
+            return info;
+        }
+
+        void advance(int numSamples) { samplePosition += numSamples; }
+    };
+
+    inline const char* modeName(LFO2AudioProcessor::RateMode mode)
+    {
+        switch (mode)
+        {
+        case LFO2AudioProcessor::RateMode::BPM:    return "BPM";
+        case LFO2AudioProcessor::RateMode::HZ:     return "Hz";
+        case LFO2AudioProcessor::RateMode::BPM_HZ: return "BPM/Hz";
+        }
+        return "?";
+    }
+
+    inline const char* shapeName(LFO::Shape shape)
+    {
+        switch (shape)
+        {
+        case LFO::Shape::Saw:      return "Saw";
+        case LFO::Shape::Sine:     return "Sine";
+        case LFO::Shape::Triangle: return "Triangle";
+        case LFO::Shape::Square:   return "Square";
+        case LFO::Shape::Custom:   return "Custom";
+        case LFO::Shape::RandomStep:   return "RandomStep";
+        case LFO::Shape::RandomSmooth: return "RandomSmooth";
+        }
+        return "?";
+    }
+
+    // a mono or stereo layout for the processor's main buses
+    inline bool setChannels(juce::AudioProcessor& processor, int numChannels)
+    {
+        auto set = numChannels == 1 ? juce::AudioChannelSet::mono() : juce::AudioChannelSet::stereo();
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(set);
+        layout.outputBuses.add(set);
+        for (int i = 1; i < processor.getBusCount(true); ++i)
+            layout.inputBuses.add(juce::AudioChannelSet::disabled()); // sidechain off
+        return processor.setBusesLayout(layout);
+    }
+
+    // v is sorted; p in 0..1
+    inline double percentile(const std::vector<double>& v, double p)
+    {
+        if (v.empty()) return 0.0;
+        auto index = (size_t)std::llround(p * (double)(v.size() - 1));
+        return v[std::min(index, v.size() - 1)];
+    }
+
+    inline double ticksToNs(juce::int64 ticks)
+    {
+        return (double)ticks * 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+    }
+
+    // deterministic test signal so every run processes the same input
+    inline void fillNoise(juce::AudioBuffer<float>& buffer, juce::Random& random)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* d = buffer.getWritePointer(ch);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                d[i] = random.nextFloat() * 0.5f - 0.25f;
+        }
+    }
+
+    // resident memory of the whole process in bytes, or -1 where we don't know how to ask
+    inline juce::int64 residentBytes()
+    {
+       #if JUCE_LINUX
+        long pages = 0, resident = 0;
+        if (auto* f = std::fopen("/proc/self/statm", "r"))
+        {
+            const int fields = std::fscanf(f, "%ld %ld", &pages, &resident);
+            std::fclose(f);
+            if (fields == 2)
+                return (juce::int64)resident * (juce::int64)sysconf(_SC_PAGESIZE);
+        }
+       #endif
+        return -1;
+    }
+
+    // CPU time used by every thread in the process so far, or -1 if unsupported
+    inline double processCpuSeconds()
+    {
+       #if JUCE_LINUX || JUCE_MAC
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+            return (double)usage.ru_utime.tv_sec + (double)usage.ru_utime.tv_usec * 1.0e-6
+                 + (double)usage.ru_stime.tv_sec + (double)usage.ru_stime.tv_usec * 1.0e-6;
+       #endif
+        return -1.0;
+    }
+}